@@ -0,0 +1,190 @@
+/* See LICENSE for license details. */
+/*
+ * st-bench replays byte streams through the terminal core, without any
+ * window, and reports how fast they were parsed. Files can be raw tty
+ * output or recordings made with st -r, whose size changes are replayed
+ * too.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "arg.h"
+#include "st.h"
+#include "win.h"
+
+char *argv0;
+
+#include "coreconfig.h"
+
+/* there is no window */
+void redraw(void) {}
+void wlbell(void) {}
+void wlloadcols(void) {}
+void wlresettitle(void) {}
+int wlsetcolorname(int x, const char *name) { return 0; }
+void wlsetcursor(int cursor) {}
+void wlsetsel(char *str) { free(str); }
+void wlsettitle(char *title) {}
+
+typedef struct {
+	size_t off; /* where in the byte stream it happened */
+	int col, row;
+} Resize;
+
+static Resize *resizes;
+static size_t nresizes;
+
+/* The tty output of a recording, noting where the size changed. */
+static char *
+loadrec(FILE *f, size_t *len)
+{
+	Record r = {0};
+	char *buf = NULL;
+	size_t siz = 0;
+
+	*len = 0;
+	while (recnext(f, &r)) {
+		if (r.type == REC_RESIZE) {
+			resizes = xrealloc(resizes,
+			                   (nresizes + 1) * sizeof(*resizes));
+			resizes[nresizes].off = *len;
+			resizes[nresizes].col = r.col;
+			resizes[nresizes++].row = r.row;
+		} else if (r.type == REC_DATA) {
+			if (*len + r.len > siz)
+				buf = xrealloc(buf, siz = MAX(2 * siz, *len + r.len));
+			memcpy(buf + *len, r.data, r.len);
+			*len += r.len;
+		}
+	}
+	free(r.data);
+	fclose(f);
+
+	return buf;
+}
+
+static char *
+load(char *path, size_t *len)
+{
+	struct stat st;
+	char *buf;
+	ssize_t r;
+	size_t n;
+	FILE *f;
+	int fd;
+
+	nresizes = 0;
+	if ((f = recopen(path)))
+		return loadrec(f, len);
+
+	if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) < 0)
+		die("%s: %s\n", path, strerror(errno));
+	buf = xmalloc(st.st_size ? st.st_size : 1);
+	for (n = 0; n < st.st_size; n += r) {
+		if ((r = read(fd, buf + n, st.st_size - n)) < 0)
+			die("%s: %s\n", path, strerror(errno));
+		if (r == 0)
+			break;
+	}
+	close(fd);
+	*len = n;
+
+	return buf;
+}
+
+static void
+replay(char *buf, size_t len)
+{
+	size_t off = 0, end, i = 0;
+	int n;
+
+	/* feed it in reads of ttybufsize, like ttyread does */
+	for (;;) {
+		end = (i < nresizes) ? resizes[i].off : len;
+		n = (off < end) ? twrite(buf + off, MIN(end - off, ttybufsize)) : 0;
+		off += n;
+		if (n > 0)
+			continue;
+		/* only an incomplete utf8 char is left before the resize */
+		if (i == nresizes)
+			break;
+		tresize(resizes[i].col, resizes[i].row);
+		i++;
+	}
+}
+
+static void
+bench(char *path, int count)
+{
+	struct timespec start, end;
+	size_t len, lines = 0, allocs;
+	char *buf, *p;
+	double ms;
+	int i;
+
+	buf = load(path, &len);
+	for (p = buf; len && (p = memchr(p, '\n', len - (p - buf))); p++)
+		lines++;
+
+	allocs = xallocs;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < count; i++)
+		replay(buf, len);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	allocs = xallocs - allocs;
+	free(buf);
+
+	ms = MAX(TIMEDIFF(end, start), 1E-3);
+	printf("%s: %zu bytes x %d in %.1f ms, %.2f MB/s, %.0f lines/s, "
+	       "%zu allocs\n", path, len, count, ms,
+	       len * count / (ms * 1E3), lines * count / (ms / 1E3), allocs);
+}
+
+static void
+usage(void)
+{
+	die("usage: %s [-c cols] [-r rows] [-n count] file ...\n", argv0);
+}
+
+int
+main(int argc, char *argv[])
+{
+	int cols = 80, rows = 24, count = 1;
+
+	ARGBEGIN {
+	case 'c':
+		cols = atoi(EARGF(usage()));
+		break;
+	case 'r':
+		rows = atoi(EARGF(usage()));
+		break;
+	case 'n':
+		count = atoi(EARGF(usage()));
+		break;
+	default:
+		usage();
+	} ARGEND;
+
+	if (argc == 0 || cols < 1 || rows < 1 || count < 1)
+		usage();
+
+	/* answers to queries go nowhere */
+	if ((cmdfd = open("/dev/null", O_RDWR)) < 0)
+		die("open /dev/null: %s\n", strerror(errno));
+
+	tnew(cols, rows);
+	selinit();
+	for (; argc > 0; argc--, argv++)
+		bench(argv[0], count);
+
+	return 0;
+}
@@ -8,31 +8,15 @@
 static char font[] = "Liberation Mono:pixelsize=12:antialias=true:autohint=true";
 static int borderpx = 2;
 
-/*
- * What program is execed by st depends of these precedence rules:
- * 1: program passed with -e
- * 2: utmp option
- * 3: SHELL environment variable
- * 4: value of shell in /etc/passwd
- * 5: value of shell in config.h
- */
-static char shell[] = "/bin/sh";
-static char *utmp = NULL;
-static char stty_args[] = "stty raw pass8 nl -echo -iexten -cstopb 38400";
-
-/* identification sequence returned in DA and DECID */
-static char vtiden[] = "\033[?6c";
-
 /* Kerning / character bounding-box multipliers */
 static float cwscale = 1.0;
 static float chscale = 1.0;
 
 /*
- * word delimiter string
- *
- * More advanced example: " `'\"()[]{}"
+ * nb of runes missing from the font whose fallback font is remembered;
+ * the least recently drawn are looked up again.
  */
-static char worddelimiters[] = " ";
+static int fallbackrunes = 1024;
 
 /* selection timeouts (in milliseconds) */
 static unsigned int doubleclicktimeout = 300;
@@ -42,9 +26,6 @@ static unsigned int tripleclicktimeout = 600;
 static unsigned int keyrepeatdelay = 500;
 static unsigned int keyrepeatinterval = 25;
 
-/* alt screens */
-static int allowaltscreen = 1;
-
 /*
  * blinking timeout (set to 0 to disable blinking) for the terminal blinking
  * attribute.
@@ -64,26 +45,6 @@ static unsigned int cursorthickness = 2;
  * static int bellvolume = 0;
  */
 
-/* default TERM value */
-static char termname[] = "st-256color";
-
-/*
- * spaces per tab
- *
- * When you are changing this value, don't forget to adapt the »it« value in
- * the st.info and appropriately install the st.info in the environment where
- * you use this st version.
- *
- *	it#$tabspaces,
- *
- * Secondly make sure your kernel is not expanding tabs. When running `stty
- * -a` »tab0« should appear. You can tell the terminal to not expand tabs by
- *  running following command:
- *
- *	stty tabs
- */
-static unsigned int tabspaces = 8;
-
 /* Terminal colors (16 first used in escape sequence) */
 static const char *colorname[] = {
 	/* 8 normal colors */
@@ -116,10 +77,8 @@ static const char *colorname[] = {
 
 /*
  * Default colors (colorname index)
- * foreground, background, cursor, reverse cursor
+ * cursor, reverse cursor; see coreconfig.h for the others
  */
-static unsigned int defaultfg = 7;
-static unsigned int defaultbg = 0;
 static unsigned int defaultcs = 256;
 static unsigned int defaultrcs = 257;
 
@@ -160,9 +119,11 @@ static MouseShortcut mshortcuts[] = {
 };
 
 static Axiskey ashortcuts[] = {
-	/* axis		    direction	mask		string */
-	{ AXIS_VERTICAL,    +1,		MOD_MASK_ANY,	"\031"},
-	{ AXIS_VERTICAL,    -1,		MOD_MASK_ANY,	"\005"},
+	/* axis		    direction	mask		function	argument	string */
+	{ AXIS_VERTICAL,    -1,		MOD_MASK_SHIFT,	kscrollup,	{.i = 3} },
+	{ AXIS_VERTICAL,    +1,		MOD_MASK_SHIFT,	kscrolldown,	{.i = 3} },
+	{ AXIS_VERTICAL,    +1,		MOD_MASK_ANY,	NULL,		{.i = 0},	"\031"},
+	{ AXIS_VERTICAL,    -1,		MOD_MASK_ANY,	NULL,		{.i = 0},	"\005"},
 };
 
 /* Internal keyboard shortcuts. */
@@ -178,6 +139,8 @@ static Shortcut shortcuts[] = {
 	{ MODKEY|MOD_MASK_SHIFT,        XKB_KEY_Next,           wlzoom,         {.f = -1} },
 	{ MODKEY|MOD_MASK_SHIFT,        XKB_KEY_Home,           wlzoomreset,    {.f =  0} },
 	{ MOD_MASK_SHIFT,               XKB_KEY_Insert,         selpaste,       {.i =  0} },
+	{ MOD_MASK_SHIFT,               XKB_KEY_Prior,          kscrollup,      {.i = -1} },
+	{ MOD_MASK_SHIFT,               XKB_KEY_Next,           kscrolldown,    {.i = -1} },
 	{ MODKEY,                       XKB_KEY_Num_Lock,       numlock,        {.i =  0} },
 	{ MODKEY,                       XKB_KEY_Control_L,      iso14755,       {.i =  0} },
 };
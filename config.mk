@@ -12,13 +12,16 @@ XDG_SHELL_PROTO = `pkg-config --variable=pkgdatadir wayland-protocols`/unstable/
 
 # includes and libs
 INCS = -I. -I/usr/include `pkg-config --cflags ${PKGCFG}`
-LIBS = -L/usr/lib -lc -lm -lrt -lutil `pkg-config --libs ${PKGCFG}`
+LIBS = -L/usr/lib -lc -lm -lrt -lutil -lpthread `pkg-config --libs ${PKGCFG}`
 
 # flags
 CPPFLAGS = -DVERSION=\"${VERSION}\" -D_XOPEN_SOURCE=600
 CFLAGS += -g -std=c99 -pedantic -Wall -Wvariadic-macros -Os ${INCS} ${CPPFLAGS}
 LDFLAGS += -g ${LIBS}
 
+# st-bench only links the terminal core
+BENCHLDFLAGS = -g -lc -lm -lrt -lutil
+
 # compiler and linker
 # CC = cc
 
@@ -0,0 +1,85 @@
+/* See LICENSE file for copyright and license details. */
+
+/*
+ * settings of the terminal core, shared by st and st-bench; the window's
+ * are in config.h.
+ */
+
+/*
+ * What program is execed by st depends of these precedence rules:
+ * 1: program passed with -e
+ * 2: utmp option
+ * 3: SHELL environment variable
+ * 4: value of shell in /etc/passwd
+ * 5: value of shell in coreconfig.h
+ */
+char *shell = "/bin/sh";
+char *utmp = NULL;
+char *stty_args = "stty raw pass8 nl -echo -iexten -cstopb 38400";
+
+/* identification sequence returned in DA and DECID */
+char *vtiden = "\033[?6c";
+
+/*
+ * word delimiter string
+ *
+ * More advanced example: " `'\"()[]{}"
+ */
+char *worddelimiters = " ";
+
+/*
+ * pty reads: size of the read buffer, and how many bytes and how much time
+ * (in milliseconds) one drain of the pty may take before the window gets a
+ * chance to redraw.
+ */
+unsigned int ttybufsize = 64 * 1024;
+unsigned int ttydrainmax = 4 * 1024 * 1024;
+unsigned int ttydraintimeout = 10;
+
+/*
+ * string sequences (OSC, DCS, ...) longer than this many bytes are
+ * dropped; it bounds what OSC 52 can put into the clipboard.
+ */
+unsigned int strbufmax = 16 * 1024 * 1024;
+
+/*
+ * memory, in bytes, the scrollback history may take; the oldest lines
+ * go first. Set to 0 to keep no history.
+ */
+unsigned int histsize = 32 * 1024 * 1024;
+
+/*
+ * history over histsize goes to an unlinked file in $TMPDIR instead of
+ * being dropped, and is read back with mmap(2) when scrolled to.
+ */
+int histspill = 0;
+
+/* alt screens */
+int allowaltscreen = 1;
+
+/* default TERM value */
+char *termname = "st-256color";
+
+/*
+ * spaces per tab
+ *
+ * When you are changing this value, don't forget to adapt the »it« value in
+ * the st.info and appropriately install the st.info in the environment where
+ * you use this st version.
+ *
+ *	it#$tabspaces,
+ *
+ * Secondly make sure your kernel is not expanding tabs. When running `stty
+ * -a` »tab0« should appear. You can tell the terminal to not expand tabs by
+ *  running following command:
+ *
+ *	stty tabs
+ */
+unsigned int tabspaces = 8;
+
+/*
+ * Default colors (colorname index)
+ * foreground, background
+ */
+unsigned int defaultfg = 7;
+unsigned int defaultbg = 0;
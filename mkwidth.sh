@@ -0,0 +1,127 @@
+#!/bin/sh
+# See LICENSE file for copyright and license details.
+#
+# Generate the rune width tables of width.h from the Unicode Character
+# Database:
+#
+#	mkwidth.sh version UnicodeData.txt EastAsianWidth.txt > width.h
+#
+# Widths follow the usual wcwidth(3) conventions: -1 for controls,
+# surrogates and unassigned code points, 0 for NUL, combining marks,
+# format characters and Hangul medial vowels and final consonants, 2 for
+# East Asian Wide and Fullwidth characters and 1 for everything else.
+
+if [ $# -ne 3 ]; then
+	echo "usage: $0 version UnicodeData.txt EastAsianWidth.txt" >&2
+	exit 1
+fi
+
+awk -v version="$1" -v eawfile="$3" '
+function setwidth(first, last, w,    cp) {
+	for (cp = first; cp <= last; cp++) {
+		if (cp in width)
+			width[cp] = w
+	}
+}
+
+function hexval(s,    i, c, v) {
+	v = 0
+	s = toupper(s)
+	for (i = 1; i <= length(s); i++) {
+		c = index("0123456789ABCDEF", substr(s, i, 1)) - 1
+		v = v * 16 + c
+	}
+	return v
+}
+
+BEGIN {
+	FS = ";"
+	# East Asian Width, only W and F matter
+	while ((getline line < eawfile) > 0) {
+		sub(/#.*/, "", line)
+		gsub(/[ \t]/, "", line)
+		if (line == "")
+			continue
+		split(line, f, ";")
+		if (f[2] != "W" && f[2] != "F")
+			continue
+		n = split(f[1], r, /\.\./)
+		first = hexval(r[1])
+		last = (n > 1) ? hexval(r[2]) : first
+		for (cp = first; cp <= last; cp++)
+			wide[cp] = 1
+	}
+	close(eawfile)
+}
+
+{
+	cp = hexval($1)
+	gc = $3
+	if ($2 ~ /, First>$/) {
+		first = cp
+		next
+	}
+	if ($2 !~ /, Last>$/)
+		first = cp
+
+	if (gc == "Cc" || gc == "Cs")
+		w = -1
+	else if (gc == "Mn" || gc == "Me" || gc == "Cf")
+		w = 0
+	else
+		w = 1
+	for (c = first; c <= cp; c++) {
+		if (w == 1 && wide[c])
+			width[c] = 2
+		else
+			width[c] = w
+	}
+}
+
+END {
+	width[0] = 0
+	width[173] = 1            # U+00AD SOFT HYPHEN
+	setwidth(4448, 4607, 0)   # U+1160 - U+11FF Hangul Jungseong/Jongseong
+	setwidth(55216, 55295, 0) # U+D7B0 - U+D7FF Hangul Jamo Extended-B
+
+	# stage 2: blocks of 256 widths packed into 2 bits each
+	nblk = 0
+	for (b = 0; b < 4352; b++) {
+		key = ""
+		for (i = 0; i < 64; i++) {
+			v = 0
+			for (j = 3; j >= 0; j--) {
+				cp = b * 256 + i * 4 + j
+				w = (cp in width) ? width[cp] : -1
+				v = v * 4 + ((w < 0) ? 3 : w)
+			}
+			byte[i] = v
+			key = key "," v
+		}
+		if (!(key in blkidx)) {
+			blkidx[key] = nblk
+			for (i = 0; i < 64; i++)
+				blk[nblk, i] = byte[i]
+			nblk++
+		}
+		idx[b] = blkidx[key]
+	}
+
+	printf("/* generated by mkwidth.sh from Unicode %s, do not edit */\n\n", version)
+	printf("#define WIDTH_UNICODE \"%s\"\n\n", version)
+	printf("/* block of every 256 code points */\n")
+	printf("static const %s widthidx[4352] = {", (nblk > 256) ? "unsigned short" : "unsigned char")
+	for (b = 0; b < 4352; b++)
+		printf("%s%d,", (b % 16) ? " " : "\n\t", idx[b])
+	printf("\n};\n\n")
+	printf("/* 2 bits per code point, lowest first: 0, 1, 2 or 3 for -1 */\n")
+	printf("static const unsigned char widthblk[%d][64] = {\n", nblk)
+	for (b = 0; b < nblk; b++) {
+		printf("\t{")
+		for (i = 0; i < 64; i++)
+			printf("%s%d,", (i % 16) ? " " : "\n\t\t", blk[b, i])
+		printf("\n\t},\n")
+	}
+	printf("};\n")
+}
+' "$2"
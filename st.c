@@ -3,11 +3,9 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
-/* for BTN_* definitions */
-#include <linux/input.h>
-#include <locale.h>
 #include <pwd.h>
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,6 +14,7 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/select.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -23,19 +22,10 @@
 #include <termios.h>
 #include <time.h>
 #include <unistd.h>
-#include <libgen.h>
-#include <wayland-client.h>
-#include <wayland-cursor.h>
-#include <xkbcommon/xkbcommon.h>
-#include <wld/wld.h>
-#include <wld/wayland.h>
-#include <fontconfig/fontconfig.h>
-#include <wchar.h>
 
-#include "arg.h"
-#include "xdg-shell-unstable-v5-client-protocol.h"
-
-char *argv0;
+#include "st.h"
+#include "win.h"
+#include "width.h"
 
 #if   defined(__linux)
  #include <pty.h>
@@ -45,112 +35,34 @@ char *argv0;
  #include <libutil.h>
 #endif
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+ #include <immintrin.h>
+ #define UTF8_SIMD
+#endif
+
 
 /* Arbitrary sizes */
 #define UTF_INVALID   0xFFFD
-#define UTF_SIZ       4
-#define ESC_BUF_SIZ   (128*UTF_SIZ)
-#define ESC_ARG_SIZ   16
+#define ESC_ARG_SIZ   32
 #define STR_BUF_SIZ   ESC_BUF_SIZ
 #define STR_ARG_SIZ   ESC_ARG_SIZ
-#define DRAW_BUF_SIZ  20*1024
-#define XK_ANY_MOD    UINT_MAX
-#define XK_NO_MOD     0
-#define XK_SWITCH_MOD (1<<13)
-
-#define MOD_MASK_ANY	UINT_MAX
-#define MOD_MASK_NONE	0
-#define MOD_MASK_CTRL	(1<<0)
-#define MOD_MASK_ALT	(1<<1)
-#define MOD_MASK_SHIFT	(1<<2)
-#define MOD_MASK_LOGO	(1<<3)
-
-#define AXIS_VERTICAL	WL_POINTER_AXIS_VERTICAL_SCROLL
-#define AXIS_HORIZONTAL	WL_POINTER_AXIS_HORIZONTAL_SCROLL
+#define HIST_BLK_SIZ  (64*1024)
 
 /* macros */
-#define MIN(a, b)		((a) < (b) ? (a) : (b))
-#define MAX(a, b)		((a) < (b) ? (b) : (a))
-#define LEN(a)			(sizeof(a) / sizeof(a)[0])
-#define DEFAULT(a, b)		(a) = (a) ? (a) : (b)
-#define BETWEEN(x, a, b)	((a) <= (x) && (x) <= (b))
-#define DIVCEIL(n, d)		(((n) + ((d) - 1)) / (d))
 #define ISCONTROLC0(c)		(BETWEEN(c, 0, 0x1f) || (c) == '\177')
 #define ISCONTROLC1(c)		(BETWEEN(c, 0x80, 0x9f))
 #define ISCONTROL(c)		(ISCONTROLC0(c) || ISCONTROLC1(c))
 #define ISDELIM(u)		(utf8strchr(worddelimiters, u) != NULL)
-#define LIMIT(x, a, b)		(x) = (x) < (a) ? (a) : (x) > (b) ? (b) : (x)
-#define ATTRCMP(a, b)		((a).mode != (b).mode || (a).fg != (b).fg || \
-				(a).bg != (b).bg)
-#define IS_SET(flag)		((term.mode & (flag)) != 0)
-#define TIMEDIFF(t1, t2)	((t1.tv_sec-t2.tv_sec)*1000 + \
-				(t1.tv_nsec-t2.tv_nsec)/1E6)
-#define MODBIT(x, set, bit)	((set) ? ((x) |= (bit)) : ((x) &= ~(bit)))
-
-#define TRUECOLOR(r,g,b)	(1 << 24 | (r) << 16 | (g) << 8 | (b))
-#define IS_TRUECOL(x)		(1 << 24 & (x))
-#define TRUERED(x)		(((x) & 0xff0000) >> 8)
-#define TRUEGREEN(x)		(((x) & 0xff00))
-#define TRUEBLUE(x)		(((x) & 0xff) << 8)
+#define HISTPAD(n)		(((n) + 3) & ~3) /* offsets follow spilled lines */
 
 /* constants */
 #define ISO14755CMD		"dmenu -p codepoint: </dev/null"
 
-enum glyph_attribute {
-	ATTR_NULL       = 0,
-	ATTR_BOLD       = 1 << 0,
-	ATTR_FAINT      = 1 << 1,
-	ATTR_ITALIC     = 1 << 2,
-	ATTR_UNDERLINE  = 1 << 3,
-	ATTR_BLINK      = 1 << 4,
-	ATTR_REVERSE    = 1 << 5,
-	ATTR_INVISIBLE  = 1 << 6,
-	ATTR_STRUCK     = 1 << 7,
-	ATTR_WRAP       = 1 << 8,
-	ATTR_WIDE       = 1 << 9,
-	ATTR_WDUMMY     = 1 << 10,
-	ATTR_BOLD_FAINT = ATTR_BOLD | ATTR_FAINT,
-};
-
 enum cursor_movement {
 	CURSOR_SAVE,
 	CURSOR_LOAD
 };
 
-enum cursor_state {
-	CURSOR_DEFAULT  = 0,
-	CURSOR_WRAPNEXT = 1,
-	CURSOR_ORIGIN   = 2
-};
-
-enum term_mode {
-	MODE_WRAP        = 1 << 0,
-	MODE_INSERT      = 1 << 1,
-	MODE_APPKEYPAD   = 1 << 2,
-	MODE_ALTSCREEN   = 1 << 3,
-	MODE_CRLF        = 1 << 4,
-	MODE_MOUSEBTN    = 1 << 5,
-	MODE_MOUSEMOTION = 1 << 6,
-	MODE_REVERSE     = 1 << 7,
-	MODE_KBDLOCK     = 1 << 8,
-	MODE_HIDE        = 1 << 9,
-	MODE_ECHO        = 1 << 10,
-	MODE_APPCURSOR   = 1 << 11,
-	MODE_MOUSESGR    = 1 << 12,
-	MODE_8BIT        = 1 << 13,
-	MODE_BLINK       = 1 << 14,
-	MODE_FBLINK      = 1 << 15,
-	MODE_FOCUS       = 1 << 16,
-	MODE_MOUSEX10    = 1 << 17,
-	MODE_MOUSEMANY   = 1 << 18,
-	MODE_BRCKTPASTE  = 1 << 19,
-	MODE_PRINT       = 1 << 20,
-	MODE_UTF8        = 1 << 21,
-	MODE_SIXEL       = 1 << 22,
-	MODE_MOUSE       = MODE_MOUSEBTN|MODE_MOUSEMOTION|MODE_MOUSEX10\
-	                  |MODE_MOUSEMANY,
-};
-
 enum charset {
 	CS_GRAPHIC0,
 	CS_GRAPHIC1,
@@ -162,67 +74,50 @@ enum charset {
 };
 
 enum escape_state {
-	ESC_START      = 1,
-	ESC_CSI        = 2,
-	ESC_STR        = 4,  /* OSC, PM, APC */
-	ESC_ALTCHARSET = 8,
-	ESC_STR_END    = 16, /* a final string was encountered */
-	ESC_TEST       = 32, /* Enter in test mode */
-	ESC_UTF8       = 64,
-	ESC_DCS        =128,
-};
-
-enum window_state {
-	WIN_VISIBLE = 1,
-	WIN_FOCUSED = 2
-};
-
-enum selection_mode {
-	SEL_IDLE = 0,
-	SEL_EMPTY = 1,
-	SEL_READY = 2
+	ESC_GROUND,          /* not in a sequence */
+	ESC_START,           /* ESC was received */
+	ESC_CSI,
+	ESC_STR,             /* OSC, PM, APC, DCS */
+	ESC_STR_END,         /* a string was ended by ESC, waiting for '\\' */
+	ESC_ALTCHARSET,
+	ESC_TEST,            /* Enter in test mode */
+	ESC_UTF8,
+	ESC_LAST
 };
 
-enum selection_type {
-	SEL_REGULAR = 1,
-	SEL_RECTANGULAR = 2
+enum escape_class {
+	CLASS_CTL,           /* C0 controls and DEL */
+	CLASS_BEL,
+	CLASS_CAN,           /* CAN and SUB */
+	CLASS_ESC,
+	CLASS_C1,
+	CLASS_PARAM,         /* 0x20 - 0x3f */
+	CLASS_FINAL,         /* 0x40 - 0x7e */
+	CLASS_ST,            /* '\\' */
+	CLASS_HIGH,          /* everything from 0xa0 on */
+	CLASS_LAST
 };
 
-enum selection_snap {
-	SNAP_WORD = 1,
-	SNAP_LINE = 2
+enum escape_action {
+	ACT_PRINT,
+	ACT_EXECUTE,
+	ACT_ESCDISPATCH,
+	ACT_CSIPUT,
+	ACT_CSIDISPATCH,
+	ACT_STRPUT,
+	ACT_STREND,
+	ACT_STRDISPATCH,
+	ACT_CHARSET,
+	ACT_TEST,
+	ACT_UTF8
 };
 
-typedef unsigned char uchar;
-typedef unsigned int uint;
-typedef unsigned long ulong;
-typedef unsigned short ushort;
-
-typedef uint_least32_t Rune;
-
-typedef struct {
-	Rune u;           /* character code */
-	ushort mode;      /* attribute flags */
-	uint32_t fg;      /* foreground  */
-	uint32_t bg;      /* background  */
-} Glyph;
-
-typedef Glyph *Line;
-
-typedef struct {
-	Glyph attr; /* current char attributes */
-	int x;
-	int y;
-	char state;
-} TCursor;
-
 /* CSI Escape sequence structs */
-/* ESC '[' [[ [<priv>] <arg> [;]] <mode> [<mode>]] */
+/* ESC '[' [[ [<priv>] <arg> [;:]] <mode> [<mode>]] */
 typedef struct {
-	char buf[ESC_BUF_SIZ]; /* raw string */
-	int len;               /* raw string length */
 	char priv;
 	int arg[ESC_ARG_SIZ];
+	char sub[ESC_ARG_SIZ]; /* arg is a ':' sub-parameter */
 	int narg;              /* nb of args */
 	char mode[2];
 } CSIEscape;
@@ -231,202 +126,52 @@ typedef struct {
 /* ESC type [[ [<priv>] <arg> [;]] <mode>] ESC '\' */
 typedef struct {
 	char type;             /* ESC type ... */
-	char buf[STR_BUF_SIZ]; /* raw string */
-	int len;               /* raw string length */
+	char *buf;             /* raw string, split into args as it arrives */
+	size_t siz;            /* allocated size of buf */
+	size_t len;            /* raw string length */
 	char *args[STR_ARG_SIZ];
 	int narg;              /* nb of args */
+	int overflow;          /* more than strbufmax bytes were sent */
+	int b64;               /* decoding base64 into the last arg */
+	uint b64bits, b64n;
+	int query;             /* that arg is just "?" */
 } STREscape;
 
-/* Internal representation of the screen */
-typedef struct {
-	int row;      /* nb row */
-	int col;      /* nb col */
-	Line *line;   /* screen */
-	Line *alt;    /* alternate screen */
-	int *dirty;  /* dirtyness of lines */
-	TCursor c;    /* cursor */
-	int top;      /* top    scroll limit */
-	int bot;      /* bottom scroll limit */
-	int mode;     /* terminal mode flags */
-	int esc;      /* escape state flags */
-	char trantbl[4]; /* charset table translation */
-	int charset;  /* current charset */
-	int icharset; /* selected charset for sequence */
-	int numlock; /* lock numbers in keyboard */
-	int *tabs;
-} Term;
-
-typedef struct {
-	struct xkb_context *ctx;
-	struct xkb_keymap *keymap;
-	struct xkb_state *state;
-	xkb_mod_index_t ctrl, alt, shift, logo;
-	unsigned int mods;
-} XKB;
-
-typedef struct {
-	struct wl_display *dpy;
-	struct wl_compositor *cmp;
-	struct wl_shm *shm;
-	struct wl_seat *seat;
-	struct wl_keyboard *keyboard;
-	struct wl_pointer *pointer;
-	struct wl_data_device_manager *datadevmanager;
-	struct wl_data_device *datadev;
-	struct wl_data_offer *seloffer;
-	struct wl_surface *surface;
-	struct wl_buffer *buffer;
-	struct xdg_shell *shell;
-	struct xdg_surface *xdgsurface;
-	XKB xkb;
-	bool configured;
-	int px, py; /* pointer x and y */
-	int tw, th; /* tty width and height */
-	int w, h; /* window width and height */
-	int ch; /* char height */
-	int cw; /* char width  */
-	int vis;
-	char state; /* focus, redraw, visible */
-	int cursor; /* cursor style */
-	struct wl_callback * framecb;
-} Wayland;
-
-typedef struct {
-	struct wld_context *ctx;
-	struct wld_font_context *fontctx;
-	struct wld_renderer *renderer;
-	struct wld_buffer *buffer, *oldbuffer;
-} WLD;
-
+/* Scrollback, lines encoded back to back in blocks */
 typedef struct {
-	struct wl_cursor_theme *theme;
-	struct wl_cursor *cursor;
-	struct wl_surface *surface;
-} Cursor;
-
-typedef struct {
-	uint b;
-	uint mask;
-	char *s;
-} MouseShortcut;
-
-typedef struct {
-	int axis;
-	int dir;
-	uint mask;
-	char s[ESC_BUF_SIZ];
-} Axiskey;
-
-typedef struct {
-	xkb_keysym_t k;
-	uint mask;
-	char *s;
-	/* three valued logic variables: 0 indifferent, 1 on, -1 off */
-	signed char appkey;    /* application keypad */
-	signed char appcursor; /* application cursor */
-	signed char crlf;      /* crlf mode          */
-} Key;
-
-typedef struct {
-	int mode;
-	int type;
-	int snap;
-	/*
-	 * Selection variables:
-	 * nb – normalized coordinates of the beginning of the selection
-	 * ne – normalized coordinates of the end of the selection
-	 * ob – original coordinates of the beginning of the selection
-	 * oe – original coordinates of the end of the selection
-	 */
-	struct {
-		int x, y;
-	} nb, ne, ob, oe;
-
-	char *primary;
-	struct wl_data_source *source;
-	int alt;
-	uint32_t tclick1, tclick2;
-} Selection;
-
-typedef union {
-	int i;
-	uint ui;
-	float f;
-	const void *v;
-} Arg;
-
-typedef struct {
-	uint mod;
-	xkb_keysym_t keysym;
-	void (*func)(const Arg *);
-	const Arg arg;
-} Shortcut;
-
-typedef struct {
-	char str[32];
-	uint32_t key;
-	int len;
-	bool started;
-	struct timespec last;
-} Repeat;
-
-/* function definitions used in config.h */
-static void numlock(const Arg *);
-static void selpaste(const Arg *);
-static void wlzoom(const Arg *);
-static void wlzoomabs(const Arg *);
-static void wlzoomreset(const Arg *);
-static void printsel(const Arg *);
-static void printscreen(const Arg *) ;
-static void iso14755(const Arg *);
-static void toggleprinter(const Arg *);
-static void sendbreak(const Arg *);
-
-/* Config.h for applying patches and the configuration. */
-#include "config.h"
-
-/* Font structure */
-typedef struct {
-	int height;
-	int width;
-	int ascent;
-	int descent;
-	int badslant;
-	int badweight;
-	short lbearing;
-	short rbearing;
-	struct wld_font *match;
-	FcFontSet *set;
-	FcPattern *pattern;
-} Font;
-
-/* Drawing Context */
+	char *buf;
+	size_t len;
+	size_t siz;
+	uint32_t *off; /* where each line starts in buf */
+	int n;         /* nb of lines */
+	int cap;
+	ulong first;   /* nb of the first line */
+	off_t foff;    /* where it is in the spill file, if buf is NULL */
+} HistBlock;
+
+/* laying the cells of a line out in rows of col cells */
 typedef struct {
-	uint32_t col[MAX(LEN(colorname), 256)];
-	Font font, bfont, ifont, ibfont;
-} DC;
-
-static void die(const char *, ...);
-static void draw(void);
-static void redraw(void);
-static void drawregion(int, int, int, int);
-static void execsh(void);
-static void stty(void);
+	int col;
+	int y, x;      /* where the next cell goes */
+	Line *out;     /* where rows y0 to y0+nout-1 are copied, if any */
+	int y0, nout;
+	Glyph pad;     /* a blank wrapped before a wide char, maybe */
+} Flow;
+
+static void execsh(char **);
+static void stty(char **);
 static void sigchld(int);
-static void run(void);
-static void cresize(int, int);
 
 static void csidump(void);
 static void csihandle(void);
-static void csiparse(void);
+static void csiput(uchar);
 static void csireset(void);
-static int eschandle(uchar);
+static void eschandle(uchar);
 static void strdump(void);
 static void strhandle(void);
-static void strparse(void);
+static void strput(char *, int);
 static void strreset(void);
 
-static int tattrset(int);
 static void tprinter(char *, size_t);
 static void tdumpsel(void);
 static void tdumpline(int);
@@ -437,195 +182,212 @@ static void tdeletechar(int);
 static void tdeleteline(int);
 static void tinsertblank(int);
 static void tinsertblankline(int);
-static int tlinelen(int);
 static void tmoveto(int, int);
 static void tmoveato(int, int);
-static void tnew(int, int);
 static void tnewline(int);
 static void tputtab(int);
 static void tputc(Rune);
+static int tputascii(Rune *, int);
 static void treset(void);
-static void tresize(int, int);
 static void tscrollup(int, int);
 static void tscrolldown(int, int);
-static void tsetattr(int *, int);
+static void tsetattr(int *, char *, int);
 static void tsetchar(Rune, Glyph *, int, int);
+static void tsetdirtcols(int, int, int);
+static void tlineinfo(Line, int);
+static void tlinechanged(Line, int, int);
 static void tsetscroll(int, int);
+static void tmirror(int, int);
+static void trotate(int);
 static void tswapscreen(void);
-static void tsetdirt(int, int);
-static void tsetdirtattr(int);
+static void tresizegrid(Glyph **, Line **, Line *, int, int, int, int);
+static int treflow(int, int);
+static void tflow(Flow *, Glyph *, int);
+static int tlinetrim(Line, int);
+static void tstyleadd(ushort);
+static void tstylegc(void);
 static void tsetmode(int, int, int *, int);
-static void tfulldirt(void);
 static void techo(Rune);
 static void tcontrolcode(uchar );
 static void tdectest(char );
 static void tdefutf8(char);
-static int32_t tdefcolor(int *, int *, int);
+static int32_t tdefcolor(int *, int *, int, int);
 static void tdeftran(char);
-static inline int match(uint, uint);
-static void ttynew(void);
-static size_t ttyread(void);
-static void ttyresize(void);
-static void ttysend(char *, size_t);
-static void ttywrite(const char *, size_t);
 static void tstrsequence(uchar);
 
-static inline uchar sixd_to_8bit(int);
-static void wldraws(char *, Glyph, int, int, int, int);
-static void wldrawglyph(Glyph, int, int);
-static void wlclear(int, int, int, int);
-static void wldrawcursor(void);
-static void wlinit(void);
-static void wlloadcols(void);
-static int wlsetcolorname(int, const char *);
-static void wlloadcursor(void);
-static int wlloadfont(Font *, FcPattern *);
-static void wlloadfonts(char *, double);
-static void wlsettitle(char *);
-static void wlresettitle(void);
-static void wlseturgency(int);
-static void wlsetsel(char*, uint32_t);
-static void wlunloadfont(Font *f);
-static void wlunloadfonts(void);
-static void wlresize(int, int);
-
-static void regglobal(void *, struct wl_registry *, uint32_t, const char *,
-		uint32_t);
-static void regglobalremove(void *, struct wl_registry *, uint32_t);
-static void surfenter(void *, struct wl_surface *, struct wl_output *);
-static void surfleave(void *, struct wl_surface *, struct wl_output *);
-static void framedone(void *, struct wl_callback *, uint32_t);
-static void kbdkeymap(void *, struct wl_keyboard *, uint32_t, int32_t, uint32_t);
-static void kbdenter(void *, struct wl_keyboard *, uint32_t,
-		struct wl_surface *, struct wl_array *);
-static void kbdleave(void *, struct wl_keyboard *, uint32_t,
-		struct wl_surface *);
-static void kbdkey(void *, struct wl_keyboard *, uint32_t, uint32_t, uint32_t,
-		uint32_t);
-static void kbdmodifiers(void *, struct wl_keyboard *, uint32_t, uint32_t,
-		uint32_t, uint32_t, uint32_t);
-static void kbdrepeatinfo(void *, struct wl_keyboard *, int32_t, int32_t);
-static void ptrenter(void *, struct wl_pointer *, uint32_t, struct wl_surface *,
-		wl_fixed_t, wl_fixed_t);
-static void ptrleave(void *, struct wl_pointer *, uint32_t,
-		struct wl_surface *);
-static void ptrmotion(void *, struct wl_pointer *, uint32_t,
-		wl_fixed_t, wl_fixed_t);
-static void ptrbutton(void *, struct wl_pointer *, uint32_t, uint32_t,
-		uint32_t, uint32_t);
-static void ptraxis(void *, struct wl_pointer *, uint32_t, uint32_t,
-		wl_fixed_t);
-static void xdgshellping(void *, struct xdg_shell *, uint32_t);
-static void xdgsurfconfigure(void *, struct xdg_surface *,
-		int32_t, int32_t, struct wl_array *, uint32_t);
-static void xdgsurfclose(void *, struct xdg_surface *);
-static void datadevoffer(void *, struct wl_data_device *,
-		struct wl_data_offer *);
-static void datadeventer(void *, struct wl_data_device *, uint32_t,
-		struct wl_surface *, wl_fixed_t, wl_fixed_t, struct wl_data_offer *);
-static void datadevleave(void *, struct wl_data_device *);
-static void datadevmotion(void *, struct wl_data_device *, uint32_t,
-		wl_fixed_t x, wl_fixed_t y);
-static void datadevdrop(void *, struct wl_data_device *);
-static void datadevselection(void *, struct wl_data_device *,
-		struct wl_data_offer *);
-static void dataofferoffer(void *, struct wl_data_offer *, const char *);
-static void datasrctarget(void *, struct wl_data_source *, const char *);
-static void datasrcsend(void *, struct wl_data_source *, const char *, int32_t);
-static void datasrccancelled(void *, struct wl_data_source *);
-
-static void selinit(void);
-static void selnormalize(void);
-static inline int selected(int, int);
-static char *getsel(void);
-static void selcopy(uint32_t);
+static int selinregion(int, int, int, int);
 static void selscroll(int, int);
-static void selsnap(int *, int *, int);
-static int x2col(int);
-static int y2row(int);
 
-static size_t utf8decode(char *, Rune *, size_t);
+static void histdecode(char *, size_t, Line, int);
+static void histdrop(void);
+static size_t histencode(Line, int, char *);
+static ulong histflow(Flow *, ulong);
+static ulong histhead(ulong);
+static char *histline(ulong, size_t *);
+static void histpush(Line, int);
+static int histseek(int, ulong *, int *);
+static ulong histstart(ulong);
+static int histtake(Glyph **);
+static void histunwrap(void);
+static void histview(void);
+static int histwrite(HistBlock *);
+
+static size_t utf8decodebuf(char *, size_t, Rune *, size_t, size_t *);
 static Rune utf8decodebyte(char, size_t *);
-static size_t utf8encode(Rune, char *);
 static char utf8encodebyte(Rune, size_t);
 static char *utf8strchr(char *s, Rune u);
 static size_t utf8validate(Rune *, size_t);
 
 static ssize_t xwrite(int, const char *, size_t);
-static void *xmalloc(size_t);
-static void *xrealloc(void *, size_t);
-static char *xstrdup(char *);
-
-static void usage(void);
-
-static struct wl_registry_listener reglistener = { regglobal, regglobalremove };
-static struct wl_surface_listener surflistener = { surfenter, surfleave };
-static struct wl_callback_listener framelistener = { framedone };
-static struct wl_keyboard_listener kbdlistener =
-	{ kbdkeymap, kbdenter, kbdleave, kbdkey, kbdmodifiers, kbdrepeatinfo };
-static struct wl_pointer_listener ptrlistener =
-	{ ptrenter, ptrleave, ptrmotion, ptrbutton, ptraxis };
-static struct xdg_shell_listener xdgshelllistener = { xdgshellping };
-static struct xdg_surface_listener xdgsurflistener =
-	{ xdgsurfconfigure, xdgsurfclose };
-static struct wl_data_device_listener datadevlistener =
-	{ datadevoffer, datadeventer, datadevleave, datadevmotion, datadevdrop,
-	  datadevselection };
-static struct wl_data_offer_listener dataofferlistener = { dataofferoffer };
-static struct wl_data_source_listener datasrclistener =
-	{ datasrctarget, datasrcsend, datasrccancelled };
+
+static size_t putvarint(uchar *, ulong);
+static int getvarint(FILE *, ulong *);
+static size_t readvarint(char *, ulong *);
+static void recwrite(int, ulong, ulong, char *, size_t);
+static void recdata(char *, size_t);
+static void recresize(int, int);
 
 /* Globals */
-static DC dc;
-static Wayland wl;
-static WLD wld;
-static Cursor cursor;
-static Term term;
+Term term;
+Selection sel;
+Style styles[STYLE_MAX];
+int cmdfd;
+bool needdraw = true;
+size_t xallocs; /* calls to xmalloc and xrealloc, for st-bench */
 static CSIEscape csiescseq;
 static STREscape strescseq;
-static int cmdfd;
 static pid_t pid;
-static Selection sel;
-static Repeat repeat;
-static bool needdraw = true;
 static int iofd = 1;
-static char **opt_cmd  = NULL;
-static char *opt_class = NULL;
-static char *opt_embed = NULL;
-static char *opt_font  = NULL;
-static char *opt_io    = NULL;
-static char *opt_line  = NULL;
-static char *opt_name  = NULL;
-static char *opt_title = NULL;
-static int oldbutton   = 3; /* button event on startup: 3 = release */
-static int oldx, oldy;
-
-static char *usedfont = NULL;
-static double usedfontsize = 0;
-static double defaultfontsize = 0;
+static int recfd = -1;
+
+/* interned colors: hash of style ids + 1, ids of collected styles */
+#define STYLE_HASH    (1 << 17)
+#define STYLEHASH(fg, bg)	(((fg) * 0x9e3779b1 + (bg)) * 0x85ebca6b >> 15)
+static ushort stylehash[STYLE_HASH];
+static ushort stylefree[STYLE_MAX];
+static int nstyles, nstylefree;
+
+/* scrollback */
+static struct {
+	HistBlock *blk;
+	int nblk;
+	ulong first;   /* nb of the oldest line kept */
+	ulong end;     /* nb of the line to come */
+	size_t mem;
+	char *enc;     /* scratch for histencode */
+	size_t encsiz;
+	int nspilled;  /* nb of blocks, first ones, in the spill file */
+	off_t fend;
+	char *map;     /* the spilled block last read */
+	size_t maplen;
+	int mapblk;
+	Glyph *cells;  /* scratch for histflow */
+	int ncells;
+	/* line vline starts vdepth rows up from vend, at vcol columns */
+	ulong vline, vend;
+	int vdepth, vcol;
+	/* the layout of the last line, as of tend, if it wraps */
+	Flow tail;
+	ulong tend;
+	int topen;
+} hist;
+static int histfd = -1; /* spill file, -2 if it failed */
 
 static uchar utfbyte[UTF_SIZ + 1] = {0x80,    0, 0xC0, 0xE0, 0xF0};
 static uchar utfmask[UTF_SIZ + 1] = {0xC0, 0x80, 0xE0, 0xF0, 0xF8};
 static Rune utfmin[UTF_SIZ + 1] = {       0,    0,  0x80,  0x800,  0x10000};
 static Rune utfmax[UTF_SIZ + 1] = {0x10FFFF, 0x7F, 0x7FF, 0xFFFF, 0x10FFFF};
 
-/* Font Ring Cache */
-enum {
-	FRC_NORMAL,
-	FRC_ITALIC,
-	FRC_BOLD,
-	FRC_ITALICBOLD
+/* VT parser: byte classes of ASCII, the rest is CLASS_C1 or CLASS_HIGH */
+#define CT CLASS_CTL
+#define CP CLASS_PARAM
+#define CF CLASS_FINAL
+static uchar escclass[128] = {
+	CT, CT, CT, CT, CT, CT, CT, CLASS_BEL,
+	CT, CT, CT, CT, CT, CT, CT, CT,
+	CT, CT, CT, CT, CT, CT, CT, CT,
+	CLASS_CAN, CT, CLASS_CAN, CLASS_ESC, CT, CT, CT, CT,
+	CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP,
+	CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP, CP,
+	CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF,
+	CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CLASS_ST, CF, CF, CF,
+	CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF,
+	CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CF, CT,
 };
+#undef CT
+#undef CP
+#undef CF
 
+/*
+ * VT parser: action and following state for each state and class.
+ * Actions that start a sequence of their own (ESC [, C1 string
+ * introducers, ...) override the state given here. Controls are executed
+ * as soon as they arrive, even inside a sequence; only CAN, SUB and C1
+ * controls abort it. Strings take every character except BEL, CAN, SUB,
+ * ESC and C1 controls, which end them.
+ */
 typedef struct {
-	struct wld_font *font;
-	int flags;
-	Rune unicodep;
-} Fontcache;
-
-/* Fontcache is an array now. A new font will be appended to the array. */
-static Fontcache frc[16];
-static int frclen = 0;
+	uchar action;
+	uchar next;
+} Transition;
+
+#define EXECUTE(s) \
+	[CLASS_CTL]   = { ACT_EXECUTE, s }, \
+	[CLASS_BEL]   = { ACT_EXECUTE, s }, \
+	[CLASS_CAN]   = { ACT_EXECUTE, ESC_GROUND }, \
+	[CLASS_ESC]   = { ACT_EXECUTE, ESC_START }, \
+	[CLASS_C1]    = { ACT_EXECUTE, ESC_GROUND }
+#define ALL(a, s) \
+	[CLASS_PARAM] = { a, s }, \
+	[CLASS_FINAL] = { a, s }, \
+	[CLASS_ST]    = { a, s }, \
+	[CLASS_HIGH]  = { a, s }
+static Transition esctrans[ESC_LAST][CLASS_LAST] = {
+	[ESC_GROUND] = {
+		EXECUTE(ESC_GROUND),
+		ALL(ACT_PRINT, ESC_GROUND),
+	},
+	[ESC_START] = {
+		EXECUTE(ESC_START),
+		ALL(ACT_ESCDISPATCH, ESC_GROUND),
+	},
+	[ESC_CSI] = {
+		EXECUTE(ESC_CSI),
+		[CLASS_PARAM] = { ACT_CSIPUT, ESC_CSI },
+		[CLASS_FINAL] = { ACT_CSIDISPATCH, ESC_GROUND },
+		[CLASS_ST]    = { ACT_CSIDISPATCH, ESC_GROUND },
+		[CLASS_HIGH]  = { ACT_CSIPUT, ESC_CSI },
+	},
+	[ESC_STR] = {
+		[CLASS_CTL]   = { ACT_STRPUT, ESC_STR },
+		[CLASS_BEL]   = { ACT_STREND, ESC_GROUND },
+		[CLASS_CAN]   = { ACT_STREND, ESC_GROUND },
+		[CLASS_ESC]   = { ACT_STREND, ESC_STR_END },
+		[CLASS_C1]    = { ACT_STREND, ESC_GROUND },
+		ALL(ACT_STRPUT, ESC_STR),
+	},
+	[ESC_STR_END] = {
+		EXECUTE(ESC_STR_END),
+		[CLASS_BEL]   = { ACT_STRDISPATCH, ESC_GROUND },
+		[CLASS_ESC]   = { ACT_EXECUTE, ESC_STR_END },
+		ALL(ACT_ESCDISPATCH, ESC_GROUND),
+		[CLASS_ST]    = { ACT_STRDISPATCH, ESC_GROUND },
+	},
+	[ESC_ALTCHARSET] = {
+		EXECUTE(ESC_ALTCHARSET),
+		ALL(ACT_CHARSET, ESC_GROUND),
+	},
+	[ESC_TEST] = {
+		EXECUTE(ESC_TEST),
+		ALL(ACT_TEST, ESC_GROUND),
+	},
+	[ESC_UTF8] = {
+		EXECUTE(ESC_UTF8),
+		ALL(ACT_UTF8, ESC_GROUND),
+	},
+};
+#undef EXECUTE
+#undef ALL
 
 ssize_t
 xwrite(int fd, const char *s, size_t len)
@@ -649,6 +411,7 @@ xmalloc(size_t len)
 {
 	void *p = malloc(len);
 
+	xallocs++;
 	if (!p)
 		die("Out of memory\n");
 
@@ -658,12 +421,25 @@ xmalloc(size_t len)
 void *
 xrealloc(void *p, size_t len)
 {
+	xallocs++;
 	if ((p = realloc(p, len)) == NULL)
 		die("Out of memory\n");
 
 	return p;
 }
 
+void *
+xmemalign(size_t align, size_t len)
+{
+	void *p;
+
+	xallocs++;
+	if (posix_memalign(&p, align, len))
+		die("Out of memory\n");
+
+	return p;
+}
+
 char *
 xstrdup(char *s)
 {
@@ -698,6 +474,136 @@ utf8decode(char *c, Rune *u, size_t clen)
 	return len;
 }
 
+/*
+ * Widen the leading run of ASCII bytes, up to but not including an ESC,
+ * into runes. Returns the number of bytes converted.
+ */
+static size_t
+utf8ascii_c(const uchar *c, size_t len, Rune *u)
+{
+	size_t i;
+
+	for (i = 0; i < len && c[i] < 0x80 && c[i] != '\033'; i++)
+		u[i] = c[i];
+
+	return i;
+}
+
+#ifdef UTF8_SIMD
+__attribute__((target("sse2"))) static size_t
+utf8ascii_sse2(const uchar *c, size_t len, Rune *u)
+{
+	__m128i v, lo, hi, zero = _mm_setzero_si128(),
+		esc = _mm_set1_epi8('\033');
+	size_t i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		v = _mm_loadu_si128((const __m128i *)&c[i]);
+		/* non-ASCII bytes and ESC both end up with the top bit set */
+		if (_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, esc))))
+			break;
+		lo = _mm_unpacklo_epi8(v, zero);
+		hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *)&u[i], _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)&u[i+4], _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)&u[i+8], _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)&u[i+12], _mm_unpackhi_epi16(hi, zero));
+	}
+
+	return i + utf8ascii_c(&c[i], len - i, &u[i]);
+}
+
+__attribute__((target("avx2"))) static size_t
+utf8ascii_avx2(const uchar *c, size_t len, Rune *u)
+{
+	__m256i v, esc = _mm256_set1_epi8('\033');
+	size_t i, j;
+
+	for (i = 0; i + 32 <= len; i += 32) {
+		v = _mm256_loadu_si256((const __m256i *)&c[i]);
+		if (_mm256_movemask_epi8(_mm256_or_si256(v,
+				_mm256_cmpeq_epi8(v, esc))))
+			break;
+		for (j = 0; j < 32; j += 8) {
+			_mm256_storeu_si256((__m256i *)&u[i+j],
+				_mm256_cvtepu8_epi32(_mm_loadl_epi64(
+				(const __m128i *)&c[i+j])));
+		}
+	}
+
+	return i + utf8ascii_c(&c[i], len - i, &u[i]);
+}
+#endif
+
+/*
+ * Decode as many complete UTF-8 sequences of c as fit into u. Invalid
+ * input decodes exactly as it does through utf8decode(). Decoding stops
+ * after an ESC or a C1 control because the sequence they start may
+ * change how the following bytes have to be decoded. Returns the number
+ * of runes stored, *n is set to the number of bytes consumed; an
+ * incomplete sequence at the end of c is left for the next call.
+ */
+size_t
+utf8decodebuf(char *s, size_t clen, Rune *u, size_t ulen, size_t *n)
+{
+	static size_t (*ascii)(const uchar *, size_t, Rune *);
+	const uchar *c = (uchar *)s;
+	size_t i, j, k, len;
+	Rune r;
+
+	if (!ascii) {
+#ifdef UTF8_SIMD
+		if (__builtin_cpu_supports("avx2"))
+			ascii = utf8ascii_avx2;
+		else if (__builtin_cpu_supports("sse2"))
+			ascii = utf8ascii_sse2;
+		else
+#endif
+			ascii = utf8ascii_c;
+	}
+
+	for (i = k = 0; i < clen && k < ulen; i += len) {
+		if (c[i] < 0x80 && c[i] != '\033') {
+			len = ascii(&c[i], MIN(clen - i, ulen - k), &u[k]);
+			k += len;
+			continue;
+		}
+
+		len = (c[i] < 0xC0) ? 0 : (c[i] < 0xE0) ? 2 :
+		      (c[i] < 0xF0) ? 3 : (c[i] < 0xF8) ? 4 : 0;
+		if (c[i] == '\033') {
+			r = c[i];
+			len = 1;
+		} else if (len == 0) {
+			r = UTF_INVALID;
+			len = 1;
+		} else {
+			r = c[i] & (0x7F >> len);
+			for (j = 1; j < len && i + j < clen; ++j) {
+				if ((c[i+j] & 0xC0) != 0x80)
+					break;
+				r = (r << 6) | (c[i+j] & 0x3F);
+			}
+			if (j < len) {
+				if (i + j == clen)
+					break;
+				r = UTF_INVALID;
+				len = j;
+			} else {
+				utf8validate(&r, len);
+			}
+		}
+		u[k++] = r;
+		if (r == '\033' || ISCONTROLC1(r)) {
+			i += len;
+			break;
+		}
+	}
+	*n = i;
+
+	return k;
+}
+
 Rune
 utf8decodebyte(char c, size_t *i)
 {
@@ -760,48 +666,49 @@ utf8validate(Rune *u, size_t i)
 	return i;
 }
 
+/*
+ * Column width of u as wcwidth(3) would report it, but from the tables in
+ * width.h so it does not depend on the locale or the C library.
+ */
+int
+runewidth(Rune u)
+{
+	int w;
+
+	if (u > 0x10FFFF)
+		return -1;
+	w = widthblk[widthidx[u >> 8]][(u & 0xff) >> 2] >> ((u & 3) * 2) & 3;
+
+	return (w == 3) ? -1 : w;
+}
+
 void
 selinit(void)
 {
-	sel.tclick1 = 0;
-	sel.tclick2 = 0;
 	sel.mode = SEL_IDLE;
 	sel.snap = 0;
 	sel.ob.x = -1;
-	sel.primary = NULL;
-	sel.source = NULL;
-}
-
-int
-x2col(int x)
-{
-	x -= borderpx;
-	x /= wl.cw;
-
-	return LIMIT(x, 0, term.col-1);
 }
 
 int
-y2row(int y)
+tlinelen(Line line)
 {
-	y -= borderpx;
-	y /= wl.ch;
+	if (line[term.col - 1].mode & ATTR_WRAP)
+		return term.col;
 
-	return LIMIT(y, 0, term.row-1);
+	return LINEINFO(line)->len;
 }
 
+/* The length of a line without the blanks at its end, on the default bg. */
 int
-tlinelen(int y)
+tlinetrim(Line line, int col)
 {
-	int i = term.col;
-
-	if (term.line[y][i - 1].mode & ATTR_WRAP)
-		return i;
-
-	while (i > 0 && term.line[y][i - 1].u == ' ')
-		--i;
+	while (col > 0 && line[col-1].u == ' ' && !line[col-1].mode
+			&& styles[line[col-1].style].bg == defaultbg) {
+		col--;
+	}
 
-	return i;
+	return col;
 }
 
 void
@@ -825,10 +732,10 @@ selnormalize(void)
 	/* expand selection over line breaks */
 	if (sel.type == SEL_RECTANGULAR)
 		return;
-	i = tlinelen(sel.nb.y);
+	i = tlinelen(TLINE(sel.nb.y));
 	if (i < sel.nb.x)
 		sel.nb.x = i;
-	if (tlinelen(sel.ne.y) <= sel.ne.x)
+	if (tlinelen(TLINE(sel.ne.y)) <= sel.ne.x)
 		sel.ne.x = term.col - 1;
 }
 
@@ -847,6 +754,24 @@ selected(int x, int y)
 	    && (y != sel.ne.y || x <= sel.ne.x);
 }
 
+/* Whether any cell of the region is selected. */
+static int
+selinregion(int x1, int y1, int x2, int y2)
+{
+	if (sel.ob.x == -1 || sel.mode == SEL_EMPTY)
+		return 0;
+	if (y2 < sel.nb.y || y1 > sel.ne.y)
+		return 0;
+
+	if (sel.type == SEL_RECTANGULAR || sel.nb.y == sel.ne.y)
+		return x1 <= sel.ne.x && x2 >= sel.nb.x;
+
+	/* only the first and last lines of a selection are partial */
+	return MAX(y1, sel.nb.y + 1) <= MIN(y2, sel.ne.y - 1)
+	    || (BETWEEN(sel.nb.y, y1, y2) && x2 >= sel.nb.x)
+	    || (BETWEEN(sel.ne.y, y1, y2) && x1 <= sel.ne.x);
+}
+
 void
 selsnap(int *x, int *y, int direction)
 {
@@ -860,7 +785,7 @@ selsnap(int *x, int *y, int direction)
 		 * Snap around if the word wraps around at the end or
 		 * beginning of a line.
 		 */
-		prevgp = &term.line[*y][*x];
+		prevgp = &TLINE(*y)[*x];
 		prevdelim = ISDELIM(prevgp->u);
 		for (;;) {
 			newx = *x + direction;
@@ -875,14 +800,14 @@ selsnap(int *x, int *y, int direction)
 					yt = *y, xt = *x;
 				else
 					yt = newy, xt = newx;
-				if (!(term.line[yt][xt].mode & ATTR_WRAP))
+				if (!(TLINE(yt)[xt].mode & ATTR_WRAP))
 					break;
 			}
 
-			if (newx >= tlinelen(newy))
+			if (newx >= tlinelen(TLINE(newy)))
 				break;
 
-			gp = &term.line[newy][newx];
+			gp = &TLINE(newy)[newx];
 			delim = ISDELIM(gp->u);
 			if (!(gp->mode & ATTR_WDUMMY) && (delim != prevdelim
 					|| (delim && gp->u != prevgp->u)))
@@ -903,14 +828,14 @@ selsnap(int *x, int *y, int direction)
 		*x = (direction < 0) ? 0 : term.col - 1;
 		if (direction < 0) {
 			for (; *y > 0; *y += direction) {
-				if (!(term.line[*y-1][term.col-1].mode
+				if (!(TLINE(*y-1)[term.col-1].mode
 						& ATTR_WRAP)) {
 					break;
 				}
 			}
 		} else if (direction > 0) {
 			for (; *y < term.row-1; *y += direction) {
-				if (!(term.line[*y][term.col-1].mode
+				if (!(TLINE(*y)[term.col-1].mode
 						& ATTR_WRAP)) {
 					break;
 				}
@@ -920,108 +845,6 @@ selsnap(int *x, int *y, int direction)
 	}
 }
 
-void
-getbuttoninfo(void)
-{
-	int type;
-	uint state = wl.xkb.mods & ~forceselmod;
-
-	sel.alt = IS_SET(MODE_ALTSCREEN);
-
-	sel.oe.x = x2col(wl.px);
-	sel.oe.y = y2row(wl.py);
-	selnormalize();
-
-	sel.type = SEL_REGULAR;
-	for (type = 1; type < LEN(selmasks); ++type) {
-		if (match(selmasks[type], state)) {
-			sel.type = type;
-			break;
-		}
-	}
-}
-
-void
-wlmousereport(int button, bool release, int x, int y)
-{
-	int len;
-	char buf[40];
-
-	if (!IS_SET(MODE_MOUSEX10)) {
-		button += ((wl.xkb.mods & MOD_MASK_SHIFT) ? 4  : 0)
-			+ ((wl.xkb.mods & MOD_MASK_LOGO ) ? 8  : 0)
-			+ ((wl.xkb.mods & MOD_MASK_CTRL ) ? 16 : 0);
-	}
-
-	if (IS_SET(MODE_MOUSESGR)) {
-		len = snprintf(buf, sizeof(buf), "\033[<%d;%d;%d%c",
-				button, x+1, y+1, release ? 'm' : 'M');
-	} else if (x < 223 && y < 223) {
-		len = snprintf(buf, sizeof(buf), "\033[M%c%c%c",
-				32+button, 32+x+1, 32+y+1);
-	} else {
-		return;
-	}
-
-	ttywrite(buf, len);
-}
-
-void
-wlmousereportbutton(uint32_t button, uint32_t state)
-{
-	bool release = state == WL_POINTER_BUTTON_STATE_RELEASED;
-
-	if (!IS_SET(MODE_MOUSESGR) && release) {
-		button = 3;
-	} else {
-		switch (button) {
-		case BTN_LEFT:
-			button = 0;
-			break;
-		case BTN_MIDDLE:
-			button = 1;
-			break;
-		case BTN_RIGHT:
-			button = 2;
-			break;
-		}
-	}
-
-	oldbutton = release ? 3 : button;
-
-	/* don't report release events when in X10 mode */
-	if (IS_SET(MODE_MOUSEX10) && release) {
-		return;
-	}
-
-	wlmousereport(button, release, oldx, oldy);
-}
-
-void
-wlmousereportmotion(wl_fixed_t fx, wl_fixed_t fy)
-{
-	int x = x2col(wl_fixed_to_int(fx)), y = y2row(wl_fixed_to_int(fy));
-
-	if (x == oldx && y == oldy)
-		return;
-	if (!IS_SET(MODE_MOUSEMOTION) && !IS_SET(MODE_MOUSEMANY))
-		return;
-	/* MOUSE_MOTION: no reporting if no button is pressed */
-	if (IS_SET(MODE_MOUSEMOTION) && oldbutton == 3)
-		return;
-
-	oldx = x;
-	oldy = y;
-	wlmousereport(oldbutton + 32, false, x, y);
-}
-
-void
-wlmousereportaxis(uint32_t axis, wl_fixed_t amount)
-{
-	wlmousereport(64 + (axis == AXIS_VERTICAL ? 4 : 6)
-		+ (amount > 0 ? 1 : 0), false, oldx, oldy);
-}
-
 char *
 getsel(void)
 {
@@ -1037,19 +860,19 @@ getsel(void)
 
 	/* append every set & selected glyph to the selection */
 	for (y = sel.nb.y; y <= sel.ne.y; y++) {
-		if ((linelen = tlinelen(y)) == 0) {
+		if ((linelen = tlinelen(TLINE(y))) == 0) {
 			*ptr++ = '\n';
 			continue;
 		}
 
 		if (sel.type == SEL_RECTANGULAR) {
-			gp = &term.line[y][sel.nb.x];
+			gp = &TLINE(y)[sel.nb.x];
 			lastx = sel.ne.x;
 		} else {
-			gp = &term.line[y][sel.nb.y == y ? sel.nb.x : 0];
+			gp = &TLINE(y)[sel.nb.y == y ? sel.nb.x : 0];
 			lastx = (sel.ne.y == y) ? sel.ne.x : term.col-1;
 		}
-		last = &term.line[y][MIN(lastx, linelen-1)];
+		last = &TLINE(y)[MIN(lastx, linelen-1)];
 		while (last >= gp && last->u == ' ')
 			--last;
 
@@ -1076,66 +899,6 @@ getsel(void)
 	return str;
 }
 
-void
-selcopy(uint32_t serial)
-{
-	wlsetsel(getsel(), serial);
-}
-
-static inline void
-selwritebuf(char *buf, int len)
-{
-	char *repl = buf;
-
-	/*
-	 * As seen in getsel:
-	 * Line endings are inconsistent in the terminal and GUI world
-	 * copy and pasting. When receiving some selection data,
-	 * replace all '\n' with '\r'.
-	 * FIXME: Fix the computer world.
-	 */
-	while ((repl = memchr(repl, '\n', len))) {
-		*repl++ = '\r';
-	}
-
-	ttysend(buf, len);
-}
-
-void
-selpaste(const Arg *dummy)
-{
-	int fds[2], len, left;
-	char buf[BUFSIZ], *str;
-
-	if (wl.seloffer) {
-		if (IS_SET(MODE_BRCKTPASTE))
-			ttywrite("\033[200~", 6);
-		/* check if we are pasting from ourselves */
-		if (sel.source) {
-			str = sel.primary;
-			left = strlen(sel.primary);
-			while (left > 0) {
-				len = MIN(sizeof buf, left);
-				memcpy(buf, str, len);
-				selwritebuf(buf, len);
-				left -= len;
-				str += len;
-			}
-		} else {
-			pipe(fds);
-			wl_data_offer_receive(wl.seloffer, "text/plain", fds[1]);
-			wl_display_flush(wl.dpy);
-			close(fds[1]);
-			while ((len = read(fds[0], buf, sizeof buf)) > 0) {
-				selwritebuf(buf, len);
-			}
-			close(fds[0]);
-		}
-		if (IS_SET(MODE_BRCKTPASTE))
-			ttywrite("\033[201~", 6);
-	}
-}
-
 void
 selclear(void)
 {
@@ -1146,22 +909,6 @@ selclear(void)
 	tsetdirt(sel.nb.y, sel.ne.y);
 }
 
-void
-wlsetsel(char *str, uint32_t serial)
-{
-	free(sel.primary);
-	sel.primary = str;
-
-	if (str) {
-		sel.source = wl_data_device_manager_create_data_source(wl.datadevmanager);
-		wl_data_source_add_listener(sel.source, &datasrclistener, NULL);
-		wl_data_source_offer(sel.source, "text/plain; charset=utf-8");
-	} else {
-		sel.source = NULL;
-	}
-	wl_data_device_set_selection(wl.datadev, sel.source, serial);
-}
-
 void
 die(const char *errstr, ...)
 {
@@ -1174,9 +921,9 @@ die(const char *errstr, ...)
 }
 
 void
-execsh(void)
+execsh(char **args)
 {
-	char **args, *sh, *prog;
+	char *sh, *prog;
 	const struct passwd *pw;
 
 	errno = 0;
@@ -1190,13 +937,13 @@ execsh(void)
 	if ((sh = getenv("SHELL")) == NULL)
 		sh = (pw->pw_shell[0]) ? pw->pw_shell : shell;
 
-	if (opt_cmd)
-		prog = opt_cmd[0];
+	if (args)
+		prog = args[0];
 	else if (utmp)
 		prog = utmp;
 	else
 		prog = sh;
-	args = (opt_cmd) ? opt_cmd : (char *[]) {prog, NULL};
+	args = (args) ? args : (char *[]) {prog, NULL};
 
 	unsetenv("COLUMNS");
 	unsetenv("LINES");
@@ -1237,7 +984,7 @@ sigchld(int a)
 
 
 void
-stty(void)
+stty(char **args)
 {
 	char cmd[_POSIX_ARG_MAX], **p, *q, *s;
 	size_t n, siz;
@@ -1247,7 +994,7 @@ stty(void)
 	memcpy(cmd, stty_args, n);
 	q = cmd + n;
 	siz = sizeof(cmd) - n;
-	for (p = opt_cmd; p && (s = *p); ++p) {
+	for (p = args; p && (s = *p); ++p) {
 		if ((n = strlen(s)) > siz-1)
 			die("stty parameter length too long\n");
 		*q++ = ' ';
@@ -1261,26 +1008,26 @@ stty(void)
 }
 
 void
-ttynew(void)
+ttynew(char *line, char *out, char **args)
 {
 	int m, s;
 	struct winsize w = {term.row, term.col, 0, 0};
 
-	if (opt_io) {
+	if (out) {
 		term.mode |= MODE_PRINT;
-		iofd = (!strcmp(opt_io, "-")) ?
-			  1 : open(opt_io, O_WRONLY | O_CREAT, 0666);
+		iofd = (!strcmp(out, "-")) ?
+			  1 : open(out, O_WRONLY | O_CREAT, 0666);
 		if (iofd < 0) {
 			fprintf(stderr, "Error opening %s:%s\n",
-				opt_io, strerror(errno));
+				out, strerror(errno));
 		}
 	}
 
-	if (opt_line) {
-		if ((cmdfd = open(opt_line, O_RDWR)) < 0)
+	if (line) {
+		if ((cmdfd = open(line, O_RDWR | O_NONBLOCK)) < 0)
 			die("open line failed: %s\n", strerror(errno));
 		dup2(cmdfd, 0);
-		stty();
+		stty(args);
 		return;
 	}
 
@@ -1302,35 +1049,46 @@ ttynew(void)
 			die("ioctl TIOCSCTTY failed: %s\n", strerror(errno));
 		close(s);
 		close(m);
-		execsh();
+		execsh(args);
 		break;
 	default:
 		close(s);
 		cmdfd = m;
+		if (fcntl(cmdfd, F_SETFL, fcntl(cmdfd, F_GETFL) | O_NONBLOCK) < 0)
+			die("fcntl O_NONBLOCK failed: %s\n", strerror(errno));
 		signal(SIGCHLD, sigchld);
 		break;
 	}
 }
 
-size_t
-ttyread(void)
+/*
+ * Feed the bytes of buf through the terminal. Returns the number of
+ * bytes consumed; an incomplete utf8 char at the end is left over.
+ */
+int
+twrite(char *buf, int buflen)
 {
-	static char buf[BUFSIZ];
-	static int buflen = 0;
-	char *ptr;
+	char *ptr = buf;
 	int charsize; /* size of utf8 char in bytes */
-	Rune unicodep;
-	int ret;
-
-	/* append read bytes to unprocessed bytes */
-	if ((ret = read(cmdfd, buf+buflen, LEN(buf)-buflen)) < 0)
-		die("Couldn't read from shell: %s\n", strerror(errno));
-
-	buflen += ret;
-	ptr = buf;
+	Rune unicodep, runes[BUFSIZ];
+	size_t i, n, nrunes;
 
 	for (;;) {
-		if (IS_SET(MODE_UTF8) && !IS_SET(MODE_SIXEL)) {
+		if (IS_SET(MODE_UTF8) && !IS_SET(MODE_SIXEL) && !term.esc) {
+			/* decode everything up to the next sequence at once */
+			nrunes = utf8decodebuf(ptr, buflen, runes, LEN(runes),
+					&n);
+			if (nrunes == 0)
+				break;
+			ptr += n;
+			buflen -= n;
+			for (i = 0; i < nrunes; i += n) {
+				if ((n = tputascii(&runes[i], nrunes - i)) == 0) {
+					tputc(runes[i]);
+					n = 1;
+				}
+			}
+		} else if (IS_SET(MODE_UTF8) && !IS_SET(MODE_SIXEL)) {
 			/* process a complete utf8 char */
 			charsize = utf8decode(ptr, &unicodep, buflen);
 			if (charsize == 0)
@@ -1346,12 +1104,53 @@ ttyread(void)
 			buflen--;
 		}
 	}
-	/* keep any uncomplete utf8 char for the next call */
-	if (buflen > 0)
-		memmove(buf, ptr, buflen);
+
+	return ptr - buf;
+}
+
+/*
+ * Drain the pty until it would block or until ttydrainmax bytes or
+ * ttydraintimeout milliseconds have been spent, so a flood of output
+ * does not keep the window from being redrawn.
+ */
+size_t
+ttyread(void)
+{
+	static char *buf;
+	static int buflen = 0;
+	struct timespec start, now;
+	size_t total = 0;
+	int ret, n;
+
+	if (!buf)
+		buf = xmalloc(ttybufsize);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	do {
+		/* append read bytes to unprocessed bytes */
+		if ((ret = read(cmdfd, buf+buflen, ttybufsize-buflen)) < 0) {
+			if (errno == EAGAIN || errno == EINTR)
+				break;
+			die("Couldn't read from shell: %s\n", strerror(errno));
+		}
+		if (ret == 0)
+			break;
+		if (recfd != -1)
+			recdata(buf+buflen, ret);
+		total += ret;
+		buflen += ret;
+
+		/* keep any uncomplete utf8 char for the next read */
+		n = twrite(buf, buflen);
+		buflen -= n;
+		if (buflen > 0)
+			memmove(buf, buf + n, buflen);
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while (total < ttydrainmax && TIMEDIFF(now, start) < ttydraintimeout);
 
 	needdraw = true;
-	return ret;
+	return total;
 }
 
 void
@@ -1381,12 +1180,17 @@ ttywrite(const char *s, size_t n)
 		}
 		if (FD_ISSET(cmdfd, &wfd)) {
 			/*
-			 * Only write the bytes written by ttywrite() or the
-			 * default of 256. This seems to be a reasonable value
-			 * for a serial line. Bigger values might clog the I/O.
+			 * Only write the bytes read by ttyread(), and at least
+			 * the default of 256, which it may not find any more
+			 * now that it does not block. This seems to be a
+			 * reasonable value for a serial line. Bigger values
+			 * might clog the I/O.
 			 */
-			if ((r = write(cmdfd, s, (n < lim)? n : lim)) < 0)
-				goto write_error;
+			if ((r = write(cmdfd, s, (n < lim)? n : lim)) < 0) {
+				if (errno != EAGAIN)
+					goto write_error;
+				r = 0;
+			}
 			if (r < n) {
 				/*
 				 * We weren't able to write out everything.
@@ -1394,7 +1198,7 @@ ttywrite(const char *s, size_t n)
 				 * again. Empty it.
 				 */
 				if (n < lim)
-					lim = ttyread();
+					lim = MAX(ttyread(), 256);
 				n -= r;
 				s += r;
 			} else {
@@ -1403,7 +1207,7 @@ ttywrite(const char *s, size_t n)
 			}
 		}
 		if (FD_ISSET(cmdfd, &rfd))
-			lim = ttyread();
+			lim = MAX(ttyread(), 256);
 	}
 	return;
 
@@ -1438,28 +1242,240 @@ ttysend(char *s, size_t n)
 }
 
 void
-ttyresize(void)
+ttyresize(int tw, int th)
 {
 	struct winsize w;
 
 	w.ws_row = term.row;
 	w.ws_col = term.col;
-	w.ws_xpixel = wl.tw;
-	w.ws_ypixel = wl.th;
+	w.ws_xpixel = tw;
+	w.ws_ypixel = th;
+	if (recfd != -1)
+		recresize(term.col, term.row);
+	/* a replay has no tty behind it */
+	if (!isatty(cmdfd))
+		return;
 	if (ioctl(cmdfd, TIOCSWINSZ, &w) < 0)
 		fprintf(stderr, "Couldn't set window size: %s\n", strerror(errno));
 }
 
-int
-tattrset(int attr)
+/*
+ * Session recordings start with RECMAGIC, followed by records made of
+ * a type byte, the time since the previous record in microseconds and
+ * then either the bytes read from the tty or the new terminal size. All
+ * numbers are LEB128 varints.
+ */
+size_t
+putvarint(uchar *p, ulong v)
 {
-	int i, j;
+	size_t n = 0;
 
-	for (i = 0; i < term.row-1; i++) {
-		for (j = 0; j < term.col-1; j++) {
-			if (term.line[i][j].mode & attr)
-				return 1;
-		}
+	do {
+		p[n++] = (v & 0x7f) | ((v > 0x7f) ? 0x80 : 0);
+		v >>= 7;
+	} while (v);
+
+	return n;
+}
+
+int
+getvarint(FILE *f, ulong *v)
+{
+	int c, shift = 0;
+
+	*v = 0;
+	do {
+		if ((c = getc(f)) == EOF || shift > 63)
+			return -1;
+		*v |= (ulong)(c & 0x7f) << shift;
+		shift += 7;
+	} while (c & 0x80);
+
+	return 0;
+}
+
+size_t
+readvarint(char *p, ulong *v)
+{
+	size_t n = 0;
+	int shift = 0;
+
+	*v = 0;
+	do {
+		*v |= (ulong)(p[n] & 0x7f) << shift;
+		shift += 7;
+	} while (p[n++] & 0x80 && shift < 64);
+
+	return n;
+}
+
+void
+recwrite(int type, ulong a, ulong b, char *data, size_t len)
+{
+	static struct timespec last;
+	struct timespec now;
+	uchar hdr[1 + 3 * 10];
+	size_t n = 0;
+	ulong delay;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	delay = (now.tv_sec - last.tv_sec) * 1000000 +
+	        (now.tv_nsec - last.tv_nsec) / 1000;
+	if (last.tv_sec == 0 && last.tv_nsec == 0)
+		delay = 0;
+	last = now;
+
+	hdr[n++] = type;
+	n += putvarint(hdr + n, delay);
+	n += putvarint(hdr + n, a);
+	if (type == REC_RESIZE)
+		n += putvarint(hdr + n, b);
+	if (xwrite(recfd, (char *)hdr, n) < 0 ||
+	    (len && xwrite(recfd, data, len) < 0)) {
+		fprintf(stderr, "Error writing recording: %s\n",
+			strerror(errno));
+		close(recfd);
+		recfd = -1;
+	}
+}
+
+void
+recdata(char *data, size_t len)
+{
+	recwrite(REC_DATA, len, 0, data, len);
+}
+
+void
+recresize(int col, int row)
+{
+	recwrite(REC_RESIZE, col, row, NULL, 0);
+}
+
+/* Returns the recording at path, positioned after the magic, or NULL. */
+FILE *
+recopen(char *path)
+{
+	char magic[sizeof(RECMAGIC) - 1];
+	FILE *f;
+
+	if (!(f = fopen(path, "r")))
+		die("open %s failed: %s\n", path, strerror(errno));
+	if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+	    memcmp(magic, RECMAGIC, sizeof(magic))) {
+		fclose(f);
+		return NULL;
+	}
+
+	return f;
+}
+
+/* Reads the next record into r, returns 0 at the end of the recording. */
+int
+recnext(FILE *f, Record *r)
+{
+	ulong a, b;
+	int c;
+
+	if ((c = getc(f)) == EOF)
+		return 0;
+	r->type = c;
+	if (getvarint(f, &r->delay) < 0 || getvarint(f, &a) < 0)
+		goto corrupt;
+
+	switch (c) {
+	case REC_DATA:
+		if (a > r->siz)
+			r->data = xrealloc(r->data, r->siz = a);
+		if (fread(r->data, 1, a, f) != a)
+			goto corrupt;
+		r->len = a;
+		return 1;
+	case REC_RESIZE:
+		if (getvarint(f, &b) < 0)
+			goto corrupt;
+		r->col = a;
+		r->row = b;
+		return 1;
+	}
+
+corrupt:
+	die("corrupt recording\n");
+	return 0;
+}
+
+void
+ttyrecord(char *path)
+{
+	if ((recfd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0)
+		die("open %s failed: %s\n", path, strerror(errno));
+	if (xwrite(recfd, RECMAGIC, sizeof(RECMAGIC) - 1) < 0)
+		die("write %s failed: %s\n", path, strerror(errno));
+}
+
+/*
+ * Play a recording instead of running a shell: a child writes the
+ * recorded tty output into a socket, at the original pace if realtime is
+ * set, so it goes through ttyread() like the real thing. Size changes in
+ * the recording are ignored, the window has the final word.
+ */
+void
+ttyreplay(char *path, int realtime)
+{
+	Record r = {0};
+	struct timespec ts;
+	char buf[BUFSIZ];
+	FILE *f;
+	int s[2];
+
+	if (!(f = recopen(path)))
+		die("%s is not a recording\n", path);
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, s) < 0)
+		die("socketpair failed: %s\n", strerror(errno));
+
+	switch (pid = fork()) {
+	case -1:
+		die("fork failed\n");
+		break;
+	case 0:
+		close(s[0]);
+		while (recnext(f, &r)) {
+			if (realtime && r.delay) {
+				ts.tv_sec = r.delay / 1000000;
+				ts.tv_nsec = r.delay % 1000000 * 1000;
+				nanosleep(&ts, NULL);
+			}
+			if (r.type == REC_DATA && xwrite(s[1], r.data, r.len) < 0)
+				_exit(1);
+		}
+		/* swallow what st answers until it goes away */
+		while (read(s[1], buf, sizeof(buf)) > 0)
+			/* nothing */ ;
+		_exit(0);
+	default:
+		fclose(f);
+		close(s[1]);
+		cmdfd = s[0];
+		if (fcntl(cmdfd, F_SETFL, fcntl(cmdfd, F_GETFL) | O_NONBLOCK) < 0)
+			die("fcntl O_NONBLOCK failed: %s\n", strerror(errno));
+		break;
+	}
+}
+
+void
+ttyhangup(void)
+{
+	/* Send SIGHUP to shell */
+	kill(pid, SIGHUP);
+}
+
+int
+tblinking(void)
+{
+	int i;
+
+	for (i = 0; i < term.row; i++) {
+		if (LINEINFO(TLINE(i))->blink)
+			return 1;
 	}
 
 	return 0;
@@ -1470,28 +1486,76 @@ tsetdirt(int top, int bot)
 {
 	int i;
 
-	LIMIT(top, 0, term.row-1);
-	LIMIT(bot, 0, term.row-1);
+	top = MAX(top, 0);
+	bot = MIN(bot, term.row-1);
 
 	for (i = top; i <= bot; i++)
-		term.dirty[i] = 1;
+		term.dirty[i] = (Dirty){ 0, term.col-1 };
 
 	needdraw = true;
 }
 
 void
-tsetdirtattr(int attr)
+tsetdirtcols(int y, int x0, int x1)
 {
-	int i, j;
+	/* rows are as shown, lower down while history is */
+	if ((y += term.scroll) >= term.row)
+		return;
+	LIMIT(x0, 0, term.col-1);
+	LIMIT(x1, 0, term.col-1);
 
-	for (i = 0; i < term.row-1; i++) {
-		for (j = 0; j < term.col-1; j++) {
-			if (term.line[i][j].mode & attr) {
-				tsetdirt(i, i);
-				break;
-			}
-		}
+	term.dirty[y].x0 = MIN(term.dirty[y].x0, x0);
+	term.dirty[y].x1 = MAX(term.dirty[y].x1, x1);
+	needdraw = true;
+}
+
+void
+tsetdirtblink(void)
+{
+	int i;
+
+	for (i = 0; i < term.row; i++) {
+		if (LINEINFO(TLINE(i))->blink)
+			tsetdirt(i, i);
+	}
+}
+
+/* Count again what the info of a line of col cells sums up. */
+void
+tlineinfo(Line line, int col)
+{
+	LineInfo *li = LINEINFO(line);
+	int x;
+
+	li->blink = 0;
+	for (x = 0; x < col; x++) {
+		if (line[x].mode & ATTR_BLINK)
+			li->blink++;
+	}
+	for (x = col; x > 0 && line[x-1].u == ' '; x--)
+		/* nothing */ ;
+	li->len = x;
+}
+
+/*
+ * Keep the length of a line right after its cells x0 to x1 changed.
+ * Those before x0 must be as they were.
+ */
+void
+tlinechanged(Line line, int x0, int x1)
+{
+	LineInfo *li = LINEINFO(line);
+	int x;
+
+	if (li->len > x1 + 1)
+		return;
+	for (x = x1 + 1; x > x0 && line[x-1].u == ' '; x--)
+		/* nothing */ ;
+	if (x == x0) {
+		for (x = MIN(x0, li->len); x > 0 && line[x-1].u == ' '; x--)
+			/* nothing */ ;
 	}
+	li->len = x;
 }
 
 void
@@ -1510,6 +1574,8 @@ tcursor(int mode)
 		c[alt] = term.c;
 	} else if (mode == CURSOR_LOAD) {
 		term.c = c[alt];
+		/* the style may have been collected in the meantime */
+		term.c.attr.style = tstyle(term.c.fg, term.c.bg);
 		tmoveto(c[alt].x, c[alt].y);
 	}
 }
@@ -1521,9 +1587,9 @@ treset(void)
 
 	term.c = (TCursor){{
 		.mode = ATTR_NULL,
-		.fg = defaultfg,
-		.bg = defaultbg
-	}, .x = 0, .y = 0, .state = CURSOR_DEFAULT};
+		.style = tstyle(defaultfg, defaultbg)
+	}, .fg = defaultfg, .bg = defaultbg,
+	.x = 0, .y = 0, .state = CURSOR_DEFAULT};
 
 	memset(term.tabs, 0, term.col * sizeof(*term.tabs));
 	for (i = tabspaces; i < term.col; i += tabspaces)
@@ -1533,6 +1599,7 @@ treset(void)
 	term.mode = MODE_WRAP|MODE_UTF8;
 	memset(term.trantbl, CS_USA, sizeof(term.trantbl));
 	term.charset = 0;
+	histunwrap();
 
 	for (i = 0; i < 2; i++) {
 		tmoveto(0, 0);
@@ -1542,10 +1609,83 @@ treset(void)
 	}
 }
 
+/*
+ * Cells only keep the index of their colors in styles, as few distinct
+ * pairs are in use at a time. When the table is full, the styles no
+ * cell refers to anymore are collected.
+ */
+ushort
+tstyle(uint32_t fg, uint32_t bg)
+{
+	uint h = STYLEHASH(fg, bg);
+	int id;
+
+	for (; (id = stylehash[h]); h = (h + 1) % STYLE_HASH) {
+		if (styles[id-1].fg == fg && styles[id-1].bg == bg)
+			return id-1;
+	}
+
+	if (nstylefree > 0) {
+		id = stylefree[--nstylefree];
+	} else if (nstyles < STYLE_MAX) {
+		id = nstyles++;
+	} else {
+		tstylegc();
+		/* every style is on screen, give up on the colors */
+		return (nstylefree > 0) ? tstyle(fg, bg) : 0;
+	}
+	styles[id] = (Style){ .fg = fg, .bg = bg };
+	tstyleadd(id);
+
+	return id;
+}
+
+void
+tstyleadd(ushort id)
+{
+	uint h = STYLEHASH(styles[id].fg, styles[id].bg);
+
+	while (stylehash[h])
+		h = (h + 1) % STYLE_HASH;
+	stylehash[h] = id + 1;
+}
+
+void
+tstylegc(void)
+{
+	static uchar used[STYLE_MAX];
+	Line *screens[] = { term.line, term.alt };
+	int i, x, y;
+
+	memset(used, 0, sizeof(used));
+	used[term.c.attr.style] = 1;
+	for (i = 0; i < LEN(screens); i++) {
+		for (y = 0; y < term.row; y++) {
+			for (x = 0; x < term.col; x++)
+				used[screens[i][y][x].style] = 1;
+		}
+	}
+	for (y = 0; y < MIN(term.scroll, term.row); y++) {
+		for (x = 0; x < term.col; x++)
+			used[term.hist[y][x].style] = 1;
+	}
+
+	memset(stylehash, 0, sizeof(stylehash));
+	for (i = 0; i < nstyles; i++) {
+		if (used[i])
+			tstyleadd(i);
+		else
+			stylefree[nstylefree++] = i;
+	}
+}
+
 void
 tnew(int col, int row)
 {
-	term = (Term){ .c = { .attr = { .fg = defaultfg, .bg = defaultbg } } };
+	term = (Term){ .c = {
+		.attr = { .style = tstyle(defaultfg, defaultbg) },
+		.fg = defaultfg, .bg = defaultbg
+	} };
 	tresize(col, row);
 	term.numlock = 1;
 
@@ -1555,14 +1695,47 @@ tnew(int col, int row)
 void
 tswapscreen(void)
 {
-	Line *tmp = term.line;
+	Line *tmp = term.line, *ring = term.ring;
+	Glyph *grid = term.grid;
 
 	term.line = term.alt;
 	term.alt = tmp;
+	term.ring = term.altring;
+	term.altring = ring;
+	term.grid = term.altgrid;
+	term.altgrid = grid;
 	term.mode ^= MODE_ALTSCREEN;
+	term.scroll = 0;
 	tfulldirt();
 }
 
+/*
+ * The screen lines live in a ring of term.row pointers, stored twice in
+ * a row so that term.line, a window starting at the head of the ring,
+ * can be indexed like a plain array. Scrolling the whole screen is
+ * moving the window, lines swapped by hand have to be mirrored.
+ */
+void
+trotate(int n)
+{
+	int head = term.line - term.ring;
+
+	head = ((head + n) % term.row + term.row) % term.row;
+	term.line = term.ring + head;
+}
+
+void
+tmirror(int y0, int y1)
+{
+	int y, i;
+
+	for (y = y0; y <= y1; y++) {
+		i = term.line - term.ring + y;
+		term.ring[(i < term.row) ? i + term.row : i - term.row] =
+			term.line[y];
+	}
+}
+
 void
 tscrolldown(int orig, int n)
 {
@@ -1571,13 +1744,20 @@ tscrolldown(int orig, int n)
 
 	LIMIT(n, 0, term.bot-orig+1);
 
-	tsetdirt(orig, term.bot-n);
+	tsetdirt(orig + term.scroll, term.bot-n + term.scroll);
 	tclearregion(0, term.bot-n+1, term.col-1, term.bot);
+	if (orig == 0 && n > 0)
+		histunwrap();
 
-	for (i = term.bot; i >= orig+n; i--) {
-		temp = term.line[i];
-		term.line[i] = term.line[i-n];
-		term.line[i-n] = temp;
+	if (orig == 0 && term.bot == term.row-1) {
+		trotate(-n);
+	} else {
+		for (i = term.bot; i >= orig+n; i--) {
+			temp = term.line[i];
+			term.line[i] = term.line[i-n];
+			term.line[i-n] = temp;
+		}
+		tmirror(orig, term.bot);
 	}
 
 	selscroll(orig, n);
@@ -1586,21 +1766,34 @@ tscrolldown(int orig, int n)
 void
 tscrollup(int orig, int n)
 {
-	int i;
+	int i, scrolled = 0;
 	Line temp;
 
 	LIMIT(n, 0, term.bot-orig+1);
 
+	/* the view does not move when history is shown, nor the selection */
+	if (orig == 0 && term.bot == term.row-1 && !IS_SET(MODE_ALTSCREEN)) {
+		for (i = 0; i < n; i++)
+			histpush(term.line[i], term.col);
+		scrolled = term.scroll;
+	}
+
 	tclearregion(0, orig, term.col-1, orig+n-1);
-	tsetdirt(orig+n, term.bot);
+	tsetdirt(orig+n + term.scroll, term.bot + term.scroll);
 
-	for (i = orig; i <= term.bot-n; i++) {
-		temp = term.line[i];
-		term.line[i] = term.line[i+n];
-		term.line[i+n] = temp;
+	if (orig == 0 && term.bot == term.row-1) {
+		trotate(n);
+	} else {
+		for (i = orig; i <= term.bot-n; i++) {
+			temp = term.line[i];
+			term.line[i] = term.line[i+n];
+			term.line[i+n] = temp;
+		}
+		tmirror(orig, term.bot);
 	}
 
-	selscroll(orig, -n);
+	if (!scrolled)
+		selscroll(orig, -n);
 }
 
 void
@@ -1633,117 +1826,616 @@ selscroll(int orig, int n)
 	}
 }
 
-void
-tnewline(int first_col)
+/*
+ * Lines scrolled off the top of the screen are kept encoded: the
+ * number of cells, shifted left by one for whether the line wraps,
+ * runs of cells sharing mode and colors, as (length, mode, fg, bg)
+ * varints, and the utf8 text of the cells. Blank cells at the end are
+ * left out.
+ */
+size_t
+histencode(Line line, int col, char *buf)
 {
-	int y = term.c.y;
+	Glyph *gp, *end, *run;
+	char *p = buf;
+	int len = tlinetrim(line, col);
+	int wrap = len == col && line[col-1].mode & ATTR_WRAP;
 
-	if (y == term.bot) {
-		tscrollup(term.top, 1);
-	} else {
-		y++;
+	end = line + len;
+
+	p += putvarint((uchar *)p, (ulong)len << 1 | wrap);
+	for (run = line; run < end; run = gp) {
+		for (gp = run; gp < end && !ATTRCMP(*gp, *run); gp++)
+			/* nothing */ ;
+		p += putvarint((uchar *)p, gp - run);
+		p += putvarint((uchar *)p, run->mode);
+		p += putvarint((uchar *)p, styles[run->style].fg);
+		p += putvarint((uchar *)p, styles[run->style].bg);
+	}
+	for (gp = line; gp < end; gp++) {
+		if (gp->u < 0x80)
+			*p++ = gp->u;
+		else
+			p += utf8encode(gp->u, p);
 	}
-	tmoveto(first_col ? 0 : term.c.x, y);
+
+	return p - buf;
 }
 
 void
-csiparse(void)
+histdecode(char *p, size_t len, Line line, int col)
 {
-	char *p = csiescseq.buf, *np;
-	long int v;
+	char *end = p + len;
+	ulong n, run, mode, fg, bg;
+	Glyph g;
+	int x, i;
 
-	csiescseq.narg = 0;
-	if (*p == '?') {
-		csiescseq.priv = 1;
-		p++;
+	p += readvarint(p, &n);
+	n >>= 1;
+	for (x = 0; x < n; x += run) {
+		p += readvarint(p, &run);
+		p += readvarint(p, &mode);
+		p += readvarint(p, &fg);
+		p += readvarint(p, &bg);
+		g = (Glyph){ .mode = mode, .style = tstyle(fg, bg) };
+		for (i = x; i < MIN(x + run, col); i++)
+			line[i] = g;
 	}
+	for (x = 0; x < MIN(n, col); x++)
+		p += utf8decode(p, &line[x].u, end - p);
+	g = (Glyph){ .u = ' ', .style = tstyle(defaultfg, defaultbg) };
+	for (; x < col; x++)
+		line[x] = g;
+}
 
-	csiescseq.buf[csiescseq.len] = '\0';
-	while (p < csiescseq.buf+csiescseq.len) {
-		np = NULL;
-		v = strtol(p, &np, 10);
-		if (np == p)
-			v = 0;
-		if (v == LONG_MAX || v == LONG_MIN)
-			v = -1;
-		csiescseq.arg[csiescseq.narg++] = v;
-		p = np;
-		if (*p != ';' || csiescseq.narg == ESC_ARG_SIZ)
-			break;
-		p++;
+char *
+histline(ulong nb, size_t *len)
+{
+	HistBlock *b;
+	int lo = 0, hi = hist.nblk - 1, mid, i;
+	uint32_t *off;
+	off_t start;
+	char *buf;
+
+	while (lo < hi) {
+		mid = (lo + hi + 1) / 2;
+		if (hist.blk[mid].first <= nb)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	b = &hist.blk[lo];
+	if ((buf = b->buf)) {
+		off = b->off;
+	} else {
+		/* map whole pages, the block starts anywhere in the file */
+		start = b->foff & ~(sysconf(_SC_PAGESIZE) - 1);
+		if (!hist.map || hist.mapblk != lo) {
+			if (hist.map)
+				munmap(hist.map, hist.maplen);
+			hist.maplen = b->foff - start + HISTPAD(b->len) +
+			              b->n * sizeof(*b->off);
+			hist.map = mmap(NULL, hist.maplen, PROT_READ,
+			                MAP_SHARED, histfd, start);
+			if (hist.map == MAP_FAILED)
+				die("mmap history: %s\n", strerror(errno));
+			hist.mapblk = lo;
+		}
+		buf = hist.map + (b->foff - start);
+		off = (uint32_t *)(buf + HISTPAD(b->len));
 	}
-	csiescseq.mode[0] = *p++;
-	csiescseq.mode[1] = (p < csiescseq.buf+csiescseq.len) ? *p : '\0';
+	i = nb - b->first;
+	*len = ((i + 1 < b->n) ? off[i+1] : b->len) - off[i];
+
+	return buf + off[i];
 }
 
-/* for absolute user moves, when decom is set */
-void
-tmoveato(int x, int y)
-{
-	tmoveto(x, y + ((term.c.state & CURSOR_ORIGIN) ? term.top: 0));
+/*
+ * Write a block at the end of the spill file, its lines then their
+ * offsets, and free it. The file is unlinked as soon as it is created,
+ * it goes away with st however st exits.
+ */
+int
+histwrite(HistBlock *b)
+{
+	static const char pad[4];
+	char path[PATH_MAX];
+	char *dir;
+
+	if (histfd == -1) {
+		if (!(dir = getenv("TMPDIR")))
+			dir = "/tmp";
+		snprintf(path, sizeof(path), "%s/st-hist.XXXXXX", dir);
+		if ((histfd = mkstemp(path)) < 0)
+			goto fail;
+		unlink(path);
+		fcntl(histfd, F_SETFD, FD_CLOEXEC);
+	}
+	if (lseek(histfd, hist.fend, SEEK_SET) < 0
+			|| xwrite(histfd, b->buf, b->len) < 0
+			|| xwrite(histfd, pad, HISTPAD(b->len) - b->len) < 0
+			|| xwrite(histfd, (char *)b->off,
+			          b->n * sizeof(*b->off)) < 0) {
+		goto fail;
+	}
+
+	b->foff = hist.fend;
+	hist.fend += HISTPAD(b->len) + b->n * sizeof(*b->off);
+	free(b->buf);
+	free(b->off);
+	b->buf = NULL;
+	b->off = NULL;
+	return 0;
+
+fail:
+	fprintf(stderr, "st: cannot spill history: %s\n", strerror(errno));
+	if (histfd >= 0)
+		close(histfd);
+	histfd = -2;
+	return -1;
 }
 
 void
-tmoveto(int x, int y)
+histdrop(void)
 {
-	int miny, maxy;
+	HistBlock *b = &hist.blk[0];
 
-	if (term.c.state & CURSOR_ORIGIN) {
-		miny = term.top;
-		maxy = term.bot;
+	if (b->buf) {
+		hist.mem -= b->siz + b->cap * sizeof(*b->off);
+		free(b->buf);
+		free(b->off);
 	} else {
-		miny = 0;
-		maxy = term.row - 1;
+		hist.nspilled--;
 	}
-	term.c.state &= ~CURSOR_WRAPNEXT;
-	term.c.x = LIMIT(x, 0, term.col-1);
-	term.c.y = LIMIT(y, miny, maxy);
+	if (hist.map && hist.mapblk == 0) {
+		munmap(hist.map, hist.maplen);
+		hist.map = NULL;
+	}
+	hist.mapblk--;
+	memmove(hist.blk, hist.blk + 1, --hist.nblk * sizeof(*hist.blk));
 }
 
 void
-tsetchar(Rune u, Glyph *attr, int x, int y)
+histpush(Line line, int col)
 {
-	static char *vt100_0[62] = { /* 0x41 - 0x7e */
-		"↑", "↓", "→", "←", "█", "▚", "☃", /* A - G */
-		0, 0, 0, 0, 0, 0, 0, 0, /* H - O */
-		0, 0, 0, 0, 0, 0, 0, 0, /* P - W */
-		0, 0, 0, 0, 0, 0, 0, " ", /* X - _ */
-		"◆", "▒", "␉", "␌", "␍", "␊", "°", "±", /* ` - g */
-		"␤", "␋", "┘", "┐", "┌", "└", "┼", "⎺", /* h - o */
-		"⎻", "─", "⎼", "⎽", "├", "┤", "┴", "┬", /* p - w */
-		"│", "≤", "≥", "π", "≠", "£", "·", /* x - ~ */
-	};
+	HistBlock *b;
+	ulong first = hist.first;
+	size_t len;
+	int n, rows = 0;
+
+	if (histsize == 0)
+		return;
+
+	/* how many rows the line adds to the layout of the last one */
+	if (term.scroll) {
+		if (hist.tail.col != col || hist.tend != hist.end) {
+			hist.tail = (Flow){ .col = col };
+			hist.topen = hist.end > hist.first
+			             && histhead(hist.end - 1) & 1;
+			if (hist.topen)
+				histflow(&hist.tail, histstart(hist.end - 1));
+		}
+		if (hist.topen)
+			rows = -(hist.tail.y + 1);
+		else
+			hist.tail = (Flow){ .col = col };
+		n = tlinetrim(line, col);
+		tflow(&hist.tail, line, n);
+		rows += hist.tail.y + 1;
+		hist.topen = n == col && line[col-1].mode & ATTR_WRAP;
+		hist.tend = hist.end + 1;
+	}
+
+	len = col * (UTF_SIZ + 4 * 10) + 10;
+	if (len > hist.encsiz)
+		hist.enc = xrealloc(hist.enc, hist.encsiz = len);
+	len = histencode(line, col, hist.enc);
+
+	b = hist.nblk ? &hist.blk[hist.nblk-1] : NULL;
+	if (!b || b->len + len > b->siz) {
+		hist.blk = xrealloc(hist.blk, ++hist.nblk * sizeof(*hist.blk));
+		b = &hist.blk[hist.nblk-1];
+		*b = (HistBlock){ .siz = MAX(HIST_BLK_SIZ, len),
+		                  .first = hist.end };
+		b->buf = xmalloc(b->siz);
+		hist.mem += b->siz;
+	}
+	if (b->n == b->cap) {
+		hist.mem -= b->cap * sizeof(*b->off);
+		b->cap = b->cap ? 2 * b->cap : 256;
+		b->off = xrealloc(b->off, b->cap * sizeof(*b->off));
+		hist.mem += b->cap * sizeof(*b->off);
+	}
+	b->off[b->n++] = b->len;
+	memcpy(b->buf + b->len, hist.enc, len);
+	b->len += len;
+	hist.end++;
+
+	/* spill or drop the oldest blocks in memory over the limit */
+	while (hist.mem > histsize && hist.nspilled < hist.nblk - 1) {
+		b = &hist.blk[hist.nspilled];
+		if (histspill && histfd != -2 && !histwrite(b)) {
+			hist.mem -= b->siz + b->cap * sizeof(*b->off);
+			hist.nspilled++;
+		} else {
+			histdrop();
+		}
+	}
+	hist.first = hist.blk[0].first;
 
 	/*
-	 * The table is proudly stolen from rxvt.
+	 * Keep the view where it is: the screen moved up under the
+	 * history shown. It is laid out again if it shows the last line,
+	 * or the oldest lines were just dropped.
 	 */
-	if (term.trantbl[term.charset] == CS_GRAPHIC0 &&
-	   BETWEEN(u, 0x41, 0x7e) && vt100_0[u - 0x41])
-		utf8decode(vt100_0[u - 0x41], &u, UTF_SIZ);
-
-	if (term.line[y][x].mode & ATTR_WIDE) {
-		if (x+1 < term.col) {
-			term.line[y][x+1].u = ' ';
-			term.line[y][x+1].mode &= ~ATTR_WDUMMY;
+	if (term.scroll) {
+		if (hist.vcol == col && hist.vend == hist.end - 1) {
+			hist.vdepth += rows;
+			hist.vend = hist.end;
+		}
+		term.scroll += rows;
+		if (hist.first != first
+				|| term.scroll - term.row < hist.tail.y + 1) {
+			histview();
 		}
-	} else if (term.line[y][x].mode & ATTR_WDUMMY) {
-		term.line[y][x-1].u = ' ';
-		term.line[y][x-1].mode &= ~ATTR_WIDE;
 	}
+}
 
-	term.dirty[y] = 1;
-	term.line[y][x] = *attr;
-	term.line[y][x].u = u;
+/*
+ * Take back the lines at the end of the history which wrap onto the
+ * screen, as far as the last block goes, and return their cells.
+ */
+int
+histtake(Glyph **cells)
+{
+	HistBlock *b;
+	ulong nb, v, start;
+	size_t len;
+	int n = 0;
+	char *p;
+
+	if (hist.end == hist.first || !(histhead(hist.end - 1) & 1))
+		return 0;
+	b = &hist.blk[hist.nblk-1];
+	start = MAX(histstart(hist.end - 1), b->first);
+	for (nb = start; nb < hist.end; nb++) {
+		p = histline(nb, &len);
+		readvarint(p, &v);
+		*cells = xrealloc(*cells, (n + (v >> 1)) * sizeof(**cells));
+		histdecode(p, len, *cells + n, v >> 1);
+		n += v >> 1;
+	}
+	b->n = start - b->first;
+	b->len = b->off[b->n];
+	hist.end = start;
+
+	return n;
 }
 
+/*
+ * The screen was erased from its start: the last line of the history does
+ * not go on there any more.
+ */
 void
-tclearregion(int x1, int y1, int x2, int y2)
+histunwrap(void)
 {
-	int x, y, temp;
-	Glyph *gp;
+	HistBlock *b;
+	int i;
 
-	if (x1 > x2)
-		temp = x1, x1 = x2, x2 = temp;
+	if (IS_SET(MODE_ALTSCREEN) || hist.end == hist.first
+			|| !(histhead(hist.end - 1) & 1)) {
+		return;
+	}
+	for (i = hist.nblk - 1; hist.blk[i].first >= hist.end; i--)
+		/* nothing */ ;
+	b = &hist.blk[i];
+	/* the low bit of the first byte of the line, unless spilled */
+	if (b->buf)
+		b->buf[b->off[hist.end - 1 - b->first]] &= ~1;
+	hist.topen = 0;
+	if (BETWEEN(term.scroll, 1, term.row))
+		term.hist[term.scroll-1][term.col-1].mode &= ~ATTR_WRAP;
+}
+
+/* The nb of cells of a history line, shifted, and whether it wraps. */
+ulong
+histhead(ulong nb)
+{
+	size_t len;
+	ulong v;
+
+	readvarint(histline(nb, &len), &v);
+
+	return v;
+}
+
+/* The first of the wrapped lines ending with line nb. */
+ulong
+histstart(ulong nb)
+{
+	while (nb > hist.first && histhead(nb - 1) & 1)
+		nb--;
+
+	return nb;
+}
+
+/*
+ * Lay out the history from line nb to the first one which does not
+ * wrap, and return the line after. History is kept as it was wrapped
+ * when it scrolled off and is rewrapped here, when it is shown. Rows
+ * only counted are so without decoding when the width did not change.
+ */
+ulong
+histflow(Flow *f, ulong nb)
+{
+	ulong end = nb, v = 1;
+	/* at one column the pad a wide char leaves is a row tflow drops */
+	int n = 0, fast = !f->nout && !f->y && !f->x && f->col > 1;
+	size_t len;
+	char *p;
+
+	while (v & 1 && end < hist.end) {
+		v = histhead(end++);
+		n = v >> 1;
+		if ((v & 1) ? n != f->col : n > f->col)
+			fast = 0;
+	}
+	if (fast && end > nb) {
+		f->y = end - nb - 1;
+		f->x = n;
+		/* an empty line after a wrapped one adds no row */
+		if (f->y && !n) {
+			f->y--;
+			f->x = f->col;
+		}
+		return end;
+	}
+
+	for (; nb < end; nb++) {
+		p = histline(nb, &len);
+		readvarint(p, &v);
+		if ((n = v >> 1) > hist.ncells) {
+			hist.cells = xrealloc(hist.cells,
+			                      n * sizeof(*hist.cells));
+			hist.ncells = n;
+		}
+		histdecode(p, len, hist.cells, n);
+		tflow(f, hist.cells, n);
+	}
+
+	return end;
+}
+
+/*
+ * Find the row depth rows up from the end of the history: the line
+ * its wrapped lines start at and where it is in their layout. Returns
+ * depth, less if the history is shorter. Lines are only added at the
+ * end, the walk starts from where the last one ended.
+ */
+int
+histseek(int depth, ulong *line, int *row)
+{
+	Flow f;
+	ulong next;
+
+	if (hist.vcol != term.col || hist.vend != hist.end
+			|| hist.vline < hist.first) {
+		hist.vline = hist.vend = hist.end;
+		hist.vdepth = 0;
+		hist.vcol = term.col;
+	}
+	while (hist.vline < hist.end) {
+		f = (Flow){ .col = term.col };
+		next = histflow(&f, hist.vline);
+		if (depth > hist.vdepth - (f.y + 1))
+			break;
+		hist.vdepth -= f.y + 1;
+		hist.vline = next;
+	}
+	while (depth > hist.vdepth && hist.vline > hist.first) {
+		hist.vline = histstart(hist.vline - 1);
+		f = (Flow){ .col = term.col };
+		histflow(&f, hist.vline);
+		hist.vdepth += f.y + 1;
+	}
+
+	depth = MIN(depth, hist.vdepth);
+	*line = hist.vline;
+	*row = hist.vdepth - depth;
+
+	return depth;
+}
+
+/* Lay out the rows of history shown above the screen. */
+void
+histview(void)
+{
+	Glyph blank = { .u = ' ', .style = tstyle(defaultfg, defaultbg) };
+	Flow f;
+	ulong nb;
+	int x, y, n, row, scroll = term.scroll;
+
+	if (!term.scroll || !(term.scroll = histseek(term.scroll, &nb, &row)))
+		return;
+	n = MIN(term.scroll, term.row);
+	/* the screen moves too if the view had to */
+	tsetdirt(0, (term.scroll == scroll) ? n-1 : term.row-1);
+	for (y = 0; y < n; y++) {
+		for (x = 0; x < term.col; x++)
+			term.hist[y][x] = blank;
+	}
+	for (y = 0; y < n; y += f.y + 1 - f.y0) {
+		f = (Flow){ .col = term.col, .out = term.hist + y,
+		            .y0 = row, .nout = n - y };
+		nb = histflow(&f, nb);
+		row = 0;
+		if (f.y + 1 <= f.y0)
+			break;
+	}
+	for (y = 0; y < n; y++)
+		tlineinfo(term.hist[y], term.col);
+	/* the last line may go on on the screen */
+	if (term.scroll <= term.row && histhead(hist.end - 1) & 1)
+		term.hist[term.scroll-1][term.col-1].mode |= ATTR_WRAP;
+}
+
+void
+tsetview(int n)
+{
+	ulong nb;
+	int row;
+
+	if (n < 0 || IS_SET(MODE_ALTSCREEN))
+		n = 0;
+	if (n > 0)
+		n = histseek(n, &nb, &row);
+	if (n == term.scroll)
+		return;
+
+	term.scroll = n;
+	selclear();
+	histview();
+	tfulldirt();
+}
+
+void
+kscrollup(const Arg *a)
+{
+	int n = a->i;
+
+	if (n < 0)
+		n = term.row + n;
+	tsetview(term.scroll + n);
+}
+
+void
+kscrolldown(const Arg *a)
+{
+	int n = a->i;
+
+	if (n < 0)
+		n = term.row + n;
+	tsetview(term.scroll - n);
+}
+
+void
+tnewline(int first_col)
+{
+	int y = term.c.y;
+
+	if (y == term.bot) {
+		tscrollup(term.top, 1);
+	} else {
+		y++;
+	}
+	tmoveto(first_col ? 0 : term.c.x, y);
+}
+
+/*
+ * Parameters are accumulated as the bytes arrive, so no copy of the
+ * sequence is kept around. Values saturate at 65535 and arguments
+ * beyond ESC_ARG_SIZ are dropped.
+ */
+void
+csiput(uchar c)
+{
+	int *a;
+
+	if (BETWEEN(c, '0', '9')) {
+		if (csiescseq.narg == 0)
+			csiescseq.narg = 1;
+		if (csiescseq.narg > ESC_ARG_SIZ)
+			return;
+		a = &csiescseq.arg[csiescseq.narg-1];
+		*a = MIN(*a * 10 + c - '0', 65535);
+	} else if (c == ';' || c == ':') {
+		if (csiescseq.narg == 0)
+			csiescseq.narg = 1;
+		if (csiescseq.narg < ESC_ARG_SIZ)
+			csiescseq.sub[csiescseq.narg] = (c == ':');
+		csiescseq.narg++;
+	} else if (c == '?' && csiescseq.narg == 0 && !csiescseq.mode[0]) {
+		csiescseq.priv = 1;
+	} else if (!csiescseq.mode[0]) {
+		csiescseq.mode[0] = c;
+	} else if (!csiescseq.mode[1]) {
+		csiescseq.mode[1] = c;
+	}
+}
+
+/* for absolute user moves, when decom is set */
+void
+tmoveato(int x, int y)
+{
+	tmoveto(x, y + ((term.c.state & CURSOR_ORIGIN) ? term.top: 0));
+}
+
+void
+tmoveto(int x, int y)
+{
+	int miny, maxy;
+
+	if (term.c.state & CURSOR_ORIGIN) {
+		miny = term.top;
+		maxy = term.bot;
+	} else {
+		miny = 0;
+		maxy = term.row - 1;
+	}
+	term.c.state &= ~CURSOR_WRAPNEXT;
+	term.c.x = LIMIT(x, 0, term.col-1);
+	term.c.y = LIMIT(y, miny, maxy);
+}
+
+void
+tsetchar(Rune u, Glyph *attr, int x, int y)
+{
+	static char *vt100_0[62] = { /* 0x41 - 0x7e */
+		"↑", "↓", "→", "←", "█", "▚", "☃", /* A - G */
+		0, 0, 0, 0, 0, 0, 0, 0, /* H - O */
+		0, 0, 0, 0, 0, 0, 0, 0, /* P - W */
+		0, 0, 0, 0, 0, 0, 0, " ", /* X - _ */
+		"◆", "▒", "␉", "␌", "␍", "␊", "°", "±", /* ` - g */
+		"␤", "␋", "┘", "┐", "┌", "└", "┼", "⎺", /* h - o */
+		"⎻", "─", "⎼", "⎽", "├", "┤", "┴", "┬", /* p - w */
+		"│", "≤", "≥", "π", "≠", "£", "·", /* x - ~ */
+	};
+
+	/*
+	 * The table is proudly stolen from rxvt.
+	 */
+	if (term.trantbl[term.charset] == CS_GRAPHIC0 &&
+	   BETWEEN(u, 0x41, 0x7e) && vt100_0[u - 0x41])
+		utf8decode(vt100_0[u - 0x41], &u, UTF_SIZ);
+
+	if (term.line[y][x].mode & ATTR_WIDE) {
+		if (x+1 < term.col) {
+			term.line[y][x+1].u = ' ';
+			term.line[y][x+1].mode &= ~ATTR_WDUMMY;
+		}
+	} else if (x > 0 && term.line[y][x].mode & ATTR_WDUMMY) {
+		term.line[y][x-1].u = ' ';
+		term.line[y][x-1].mode &= ~ATTR_WIDE;
+	}
+
+	/* with both halves of wide chars */
+	tsetdirtcols(y, x-1, x+1);
+	LINEINFO(term.line[y])->blink += !!(attr->mode & ATTR_BLINK)
+	                                 - !!(term.line[y][x].mode & ATTR_BLINK);
+	term.line[y][x] = *attr;
+	term.line[y][x].u = u;
+	tlinechanged(term.line[y], MAX(x-1, 0), MIN(x+1, term.col-1));
+}
+
+void
+tclearregion(int x1, int y1, int x2, int y2)
+{
+	int i, n, x, y, temp;
+	LineInfo *li;
+	Glyph *blank;
+
+	if (x1 > x2)
+		temp = x1, x1 = x2, x2 = temp;
 	if (y1 > y2)
 		temp = y1, y1 = y2, y2 = temp;
 
@@ -1752,16 +2444,29 @@ tclearregion(int x1, int y1, int x2, int y2)
 	LIMIT(y1, 0, term.row-1);
 	LIMIT(y2, 0, term.row-1);
 
+	if (selinregion(x1, y1, x2, y2))
+		selclear();
+
+	/* fill the first row by doubling a blank, then copy it down */
+	n = x2 - x1 + 1;
+	blank = &term.line[y1][x1];
+	blank->u = ' ';
+	blank->mode = 0;
+	blank->style = term.c.attr.style;
+	for (i = 1; i < n; i += i)
+		memcpy(blank + i, blank, MIN(i, n - i) * sizeof(Glyph));
 	for (y = y1; y <= y2; y++) {
-		term.dirty[y] = 1;
-		for (x = x1; x <= x2; x++) {
-			gp = &term.line[y][x];
-			if (selected(x, y))
-				selclear();
-			gp->fg = term.c.attr.fg;
-			gp->bg = term.c.attr.bg;
-			gp->mode = 0;
-			gp->u = ' ';
+		tsetdirtcols(y, x1, x2);
+		if (y > y1)
+			memcpy(&term.line[y][x1], blank, n * sizeof(Glyph));
+		li = LINEINFO(term.line[y]);
+		if (li->blink) {
+			tlineinfo(term.line[y], term.col);
+		} else if (BETWEEN(li->len, x1 + 1, x2 + 1)) {
+			/* what is left of the line ends before x1 */
+			for (x = x1; x > 0 && term.line[y][x-1].u == ' '; x--)
+				/* nothing */ ;
+			li->len = x;
 		}
 	}
 }
@@ -1780,7 +2485,9 @@ tdeletechar(int n)
 	line = term.line[term.c.y];
 
 	memmove(&line[dst], &line[src], size * sizeof(Glyph));
+	tsetdirtcols(term.c.y, dst, term.col-1);
 	tclearregion(term.col-n, term.c.y, term.col-1, term.c.y);
+	tlinechanged(line, dst, term.col-1);
 }
 
 void
@@ -1797,7 +2504,9 @@ tinsertblank(int n)
 	line = term.line[term.c.y];
 
 	memmove(&line[dst], &line[src], size * sizeof(Glyph));
+	tsetdirtcols(term.c.y, src, term.col-1);
 	tclearregion(src, term.c.y, dst - 1, term.c.y);
+	tlinechanged(line, src, term.col-1);
 }
 
 void
@@ -1814,24 +2523,34 @@ tdeleteline(int n)
 		tscrollup(term.c.y, n);
 }
 
+/*
+ * Both the ';' form (38;2;r;g;b) and the ':' form of ITU T.416
+ * (38:2:[cs]:r:g:b) are accepted. In the latter the nsub sub-parameters
+ * are skipped by the caller and the colorspace id is optional.
+ */
 int32_t
-tdefcolor(int *attr, int *npar, int l)
+tdefcolor(int *attr, int *npar, int l, int nsub)
 {
 	int32_t idx = -1;
+	int *p = &attr[*npar + 1];
+	int n = nsub ? nsub : l - *npar - 1;
 	uint r, g, b;
 
-	switch (attr[*npar + 1]) {
+	switch (p[0]) {
 	case 2: /* direct color in RGB space */
-		if (*npar + 4 >= l) {
+		if (n < 4) {
 			fprintf(stderr,
 				"erresc(38): Incorrect number of parameters (%d)\n",
 				*npar);
 			break;
 		}
-		r = attr[*npar + 2];
-		g = attr[*npar + 3];
-		b = attr[*npar + 4];
-		*npar += 4;
+		if (nsub)
+			p += nsub - 4;
+		else
+			*npar += 4;
+		r = p[1];
+		g = p[2];
+		b = p[3];
 		if (!BETWEEN(r, 0, 255) || !BETWEEN(g, 0, 255) || !BETWEEN(b, 0, 255))
 			fprintf(stderr, "erresc: bad rgb color (%u,%u,%u)\n",
 				r, g, b);
@@ -1839,17 +2558,18 @@ tdefcolor(int *attr, int *npar, int l)
 			idx = TRUECOLOR(r, g, b);
 		break;
 	case 5: /* indexed color */
-		if (*npar + 2 >= l) {
+		if (n < 2) {
 			fprintf(stderr,
 				"erresc(38): Incorrect number of parameters (%d)\n",
 				*npar);
 			break;
 		}
-		*npar += 2;
-		if (!BETWEEN(attr[*npar], 0, 255))
-			fprintf(stderr, "erresc: bad fgcolor %d\n", attr[*npar]);
+		if (!nsub)
+			*npar += 2;
+		if (!BETWEEN(p[1], 0, 255))
+			fprintf(stderr, "erresc: bad fgcolor %d\n", p[1]);
 		else
-			idx = attr[*npar];
+			idx = p[1];
 		break;
 	case 0: /* implemented defined (only foreground) */
 	case 1: /* transparent */
@@ -1857,7 +2577,7 @@ tdefcolor(int *attr, int *npar, int l)
 	case 4: /* direct color in CMYK space */
 	default:
 		fprintf(stderr,
-		        "erresc(38): gfx attr %d unknown\n", attr[*npar]);
+		        "erresc(38): gfx attr %d unknown\n", p[0]);
 		break;
 	}
 
@@ -1865,12 +2585,14 @@ tdefcolor(int *attr, int *npar, int l)
 }
 
 void
-tsetattr(int *attr, int l)
+tsetattr(int *attr, char *sub, int l)
 {
-	int i;
+	int i, nsub;
 	int32_t idx;
 
-	for (i = 0; i < l; i++) {
+	for (i = 0; i < l; i += nsub + 1) {
+		for (nsub = 0; i + nsub + 1 < l && sub[i + nsub + 1]; nsub++)
+			/* nothing */ ;
 		switch (attr[i]) {
 		case 0:
 			term.c.attr.mode &= ~(
@@ -1882,8 +2604,8 @@ tsetattr(int *attr, int l)
 				ATTR_REVERSE    |
 				ATTR_INVISIBLE  |
 				ATTR_STRUCK     );
-			term.c.attr.fg = defaultfg;
-			term.c.attr.bg = defaultbg;
+			term.c.fg = defaultfg;
+			term.c.bg = defaultbg;
 			break;
 		case 1:
 			term.c.attr.mode |= ATTR_BOLD;
@@ -1895,7 +2617,11 @@ tsetattr(int *attr, int l)
 			term.c.attr.mode |= ATTR_ITALIC;
 			break;
 		case 4:
-			term.c.attr.mode |= ATTR_UNDERLINE;
+			/* 4:0 is no underline, other styles are plain ones */
+			if (nsub && attr[i+1] == 0)
+				term.c.attr.mode &= ~ATTR_UNDERLINE;
+			else
+				term.c.attr.mode |= ATTR_UNDERLINE;
 			break;
 		case 5: /* slow blink */
 			/* FALLTHROUGH */
@@ -1933,28 +2659,28 @@ tsetattr(int *attr, int l)
 			term.c.attr.mode &= ~ATTR_STRUCK;
 			break;
 		case 38:
-			if ((idx = tdefcolor(attr, &i, l)) >= 0)
-				term.c.attr.fg = idx;
+			if ((idx = tdefcolor(attr, &i, l, nsub)) >= 0)
+				term.c.fg = idx;
 			break;
 		case 39:
-			term.c.attr.fg = defaultfg;
+			term.c.fg = defaultfg;
 			break;
 		case 48:
-			if ((idx = tdefcolor(attr, &i, l)) >= 0)
-				term.c.attr.bg = idx;
+			if ((idx = tdefcolor(attr, &i, l, nsub)) >= 0)
+				term.c.bg = idx;
 			break;
 		case 49:
-			term.c.attr.bg = defaultbg;
+			term.c.bg = defaultbg;
 			break;
 		default:
 			if (BETWEEN(attr[i], 30, 37)) {
-				term.c.attr.fg = attr[i] - 30;
+				term.c.fg = attr[i] - 30;
 			} else if (BETWEEN(attr[i], 40, 47)) {
-				term.c.attr.bg = attr[i] - 40;
+				term.c.bg = attr[i] - 40;
 			} else if (BETWEEN(attr[i], 90, 97)) {
-				term.c.attr.fg = attr[i] - 90 + 8;
+				term.c.fg = attr[i] - 90 + 8;
 			} else if (BETWEEN(attr[i], 100, 107)) {
-				term.c.attr.bg = attr[i] - 100 + 8;
+				term.c.bg = attr[i] - 100 + 8;
 			} else {
 				fprintf(stderr,
 					"erresc(default): gfx attr %d unknown\n",
@@ -1963,6 +2689,7 @@ tsetattr(int *attr, int l)
 			break;
 		}
 	}
+	term.c.attr.style = tstyle(term.c.fg, term.c.bg);
 }
 
 void
@@ -2157,7 +2884,7 @@ csihandle(void)
 		break;
 	case 'c': /* DA -- Device Attributes */
 		if (csiescseq.arg[0] == 0)
-			ttywrite(vtiden, sizeof(vtiden) - 1);
+			ttywrite(vtiden, strlen(vtiden));
 		break;
 	case 'C': /* CUF -- Cursor <n> Forward */
 	case 'a': /* HPR -- Cursor <n> Forward */
@@ -2224,6 +2951,8 @@ csihandle(void)
 		default:
 			goto unknown;
 		}
+		if (csiescseq.arg[0] || (term.c.x == 0 && term.c.y == 0))
+			histunwrap();
 		break;
 	case 'K': /* EL -- Clear line */
 		switch (csiescseq.arg[0]) {
@@ -2238,6 +2967,8 @@ csihandle(void)
 			tclearregion(0, term.c.y, term.col-1, term.c.y);
 			break;
 		}
+		if (term.c.y == 0 && (csiescseq.arg[0] || term.c.x == 0))
+			histunwrap();
 		break;
 	case 'S': /* SU -- Scroll <n> line up */
 		DEFAULT(csiescseq.arg[0], 1);
@@ -2279,7 +3010,7 @@ csihandle(void)
 		tsetmode(csiescseq.priv, 1, csiescseq.arg, csiescseq.narg);
 		break;
 	case 'm': /* SGR -- Terminal attribute (color) */
-		tsetattr(csiescseq.arg, csiescseq.narg);
+		tsetattr(csiescseq.arg, csiescseq.sub, csiescseq.narg);
 		break;
 	case 'n': /* DSR – Device Status Report (cursor position) */
 		if (csiescseq.arg[0] == 6) {
@@ -2311,7 +3042,7 @@ csihandle(void)
 			if (!BETWEEN(csiescseq.arg[0], 0, 6)) {
 				goto unknown;
 			}
-			wl.cursor = csiescseq.arg[0];
+			wlsetcursor(csiescseq.arg[0]);
 			break;
 		default:
 			goto unknown;
@@ -2327,19 +3058,23 @@ csidump(void)
 	uint c;
 
 	fprintf(stderr, "ESC[");
-	for (i = 0; i < csiescseq.len; i++) {
-		c = csiescseq.buf[i] & 0xff;
-		if (isprint(c)) {
+	if (csiescseq.priv)
+		putc('?', stderr);
+	/* other private markers end up in mode[0] */
+	i = BETWEEN(csiescseq.mode[0], '<', '?');
+	if (i)
+		putc(csiescseq.mode[0], stderr);
+	for (c = 0; c < csiescseq.narg; c++) {
+		if (c > 0)
+			putc(csiescseq.sub[c] ? ':' : ';', stderr);
+		fprintf(stderr, "%d", csiescseq.arg[c]);
+	}
+	for (; i < LEN(csiescseq.mode) && csiescseq.mode[i]; i++) {
+		c = csiescseq.mode[i] & 0xff;
+		if (isprint(c))
 			putc(c, stderr);
-		} else if (c == '\n') {
-			fprintf(stderr, "(\\n)");
-		} else if (c == '\r') {
-			fprintf(stderr, "(\\r)");
-		} else if (c == 0x1b) {
-			fprintf(stderr, "(\\e)");
-		} else {
+		else
 			fprintf(stderr, "(%02x)", c);
-		}
 	}
 	putc('\n', stderr);
 }
@@ -2356,8 +3091,13 @@ strhandle(void)
 	char *p = NULL;
 	int j, narg, par;
 
-	term.esc &= ~(ESC_STR_END|ESC_STR);
-	strparse();
+	if (strescseq.overflow) {
+		fprintf(stderr, "erresc: str sequence longer than %u bytes\n",
+			strbufmax);
+		return;
+	}
+	if (strescseq.buf)
+		strescseq.buf[strescseq.len] = '\0';
 	par = (narg = strescseq.narg) ? atoi(strescseq.args[0]) : 0;
 
 	switch (strescseq.type) {
@@ -2386,13 +3126,16 @@ strhandle(void)
 				redraw();
 			}
 			return;
+		case 52: /* set selection, querying it is not supported */
+			if (narg > 2 && !strescseq.query)
+				wlsetsel(xstrdup(strescseq.args[2]));
+			return;
 		}
 		break;
 	case 'k': /* old title set compatibility */
 		wlsettitle(strescseq.args[0]);
 		return;
 	case 'P': /* DCS -- Device Control String */
-		term.mode |= ESC_DCS;
 	case '_': /* APC -- Application Program Command */
 	case '^': /* PM -- Privacy Message */
 		return;
@@ -2402,25 +3145,67 @@ strhandle(void)
 	strdump();
 }
 
+/*
+ * Append to the string sequence, growing the buffer up to strbufmax.
+ * Arguments are split on ';' as they arrive and the payload of OSC 52
+ * is base64 decoded in place, so nothing has to walk the whole string
+ * again once it is terminated.
+ */
 void
-strparse(void)
+strput(char *c, int len)
 {
-	int c;
-	char *p = strescseq.buf;
-
-	strescseq.narg = 0;
-	strescseq.buf[strescseq.len] = '\0';
+	static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	                          "abcdefghijklmnopqrstuvwxyz0123456789+/";
+	char *p;
+	size_t siz, off[STR_ARG_SIZ];
+	int i;
 
-	if (*p == '\0')
+	if (strescseq.overflow)
 		return;
-
-	while (strescseq.narg < STR_ARG_SIZ) {
-		strescseq.args[strescseq.narg++] = p;
-		while ((c = *p) != ';' && c != '\0')
-			++p;
-		if (c == '\0')
+	if (strescseq.len + len >= strescseq.siz) {
+		for (siz = MAX(strescseq.siz, STR_BUF_SIZ);
+		     strescseq.len + len >= siz; siz *= 2)
+			/* nothing */ ;
+		if (siz > strbufmax)
+			siz = strbufmax;
+		if (strescseq.len + len >= siz) {
+			strescseq.overflow = 1;
 			return;
-		*p++ = '\0';
+		}
+		for (i = 0; i < strescseq.narg; i++)
+			off[i] = strescseq.args[i] - strescseq.buf;
+		strescseq.buf = xrealloc(strescseq.buf, siz);
+		strescseq.siz = siz;
+		for (i = 0; i < strescseq.narg; i++)
+			strescseq.args[i] = strescseq.buf + off[i];
+	}
+
+	if (strescseq.narg == 0)
+		strescseq.args[strescseq.narg++] = strescseq.buf;
+
+	for (; len > 0; c++, len--) {
+		if (strescseq.b64) {
+			strescseq.query = *c == '?' && !strescseq.query
+				&& !strescseq.b64n && strescseq.args[2]
+				== &strescseq.buf[strescseq.len];
+			if (!(p = strchr(b64, *c)) || *c == '\0')
+				continue;
+			strescseq.b64bits = strescseq.b64bits << 6 | (p - b64);
+			if ((strescseq.b64n += 6) >= 8) {
+				strescseq.b64n -= 8;
+				strescseq.buf[strescseq.len++] =
+					strescseq.b64bits >> strescseq.b64n;
+			}
+		} else if (*c == ';' && strescseq.narg < STR_ARG_SIZ) {
+			strescseq.buf[strescseq.len++] = '\0';
+			strescseq.args[strescseq.narg++] =
+				&strescseq.buf[strescseq.len];
+			strescseq.b64 = strescseq.type == ']' &&
+				strescseq.narg == 3 &&
+				!strcmp(strescseq.args[0], "52");
+		} else {
+			strescseq.buf[strescseq.len++] = *c;
+		}
 	}
 }
 
@@ -2454,7 +3239,18 @@ strdump(void)
 void
 strreset(void)
 {
+	char *buf = strescseq.buf;
+	size_t siz = strescseq.siz;
+
+	/* don't hold on to what a huge sequence made us allocate */
+	if (siz > STR_BUF_SIZ) {
+		free(buf);
+		buf = NULL;
+		siz = 0;
+	}
 	memset(&strescseq, 0, sizeof(strescseq));
+	strescseq.buf = buf;
+	strescseq.siz = siz;
 }
 
 void
@@ -2468,8 +3264,8 @@ void
 tprinter(char *s, size_t len)
 {
 	if (iofd != -1 && xwrite(iofd, s, len) < 0) {
-		fprintf(stderr, "Error writing in %s:%s\n",
-			opt_io, strerror(errno));
+		fprintf(stderr, "Error writing to output file: %s\n",
+			strerror(errno));
 		close(iofd);
 		iofd = -1;
 	}
@@ -2533,7 +3329,7 @@ tdumpline(int n)
 	Glyph *bp, *end;
 
 	bp = &term.line[n][0];
-	end = &bp[MIN(tlinelen(n), term.col) - 1];
+	end = &bp[MIN(tlinelen(term.line[n]), term.col) - 1];
 	if (bp != end || bp->u != ' ') {
 		for ( ;bp <= end; ++bp)
 			tprinter(buf, utf8encode(bp->u, buf));
@@ -2628,7 +3424,6 @@ tstrsequence(uchar c)
 	switch (c) {
 	case 0x90:   /* DCS -- Device Control String */
 		c = 'P';
-		term.esc |= ESC_DCS;
 		break;
 	case 0x9f:   /* APC -- Application Program Command */
 		c = '_';
@@ -2641,7 +3436,7 @@ tstrsequence(uchar c)
 		break;
 	}
 	strescseq.type = c;
-	term.esc |= ESC_STR;
+	term.esc = ESC_STR;
 }
 
 void
@@ -2664,22 +3459,10 @@ tcontrolcode(uchar ascii)
 		tnewline(IS_SET(MODE_CRLF));
 		return;
 	case '\a':   /* BEL */
-		if (term.esc & ESC_STR_END) {
-			/* backwards compatibility to xterm */
-			strhandle();
-		} else {
-			if (!(wl.state & WIN_FOCUSED))
-				wlseturgency(1);
-			/* XXX: No bell on wayland
-			 * if (bellvolume)
-			 *     XkbBell(xw.dpy, xw.win, bellvolume, (Atom)NULL);
-			 */
-		}
-		break;
+		wlbell();
+		return;
 	case '\033': /* ESC */
 		csireset();
-		term.esc &= ~(ESC_CSI|ESC_ALTCHARSET|ESC_TEST);
-		term.esc |= ESC_START;
 		return;
 	case '\016': /* SO (LS1 -- Locking shift 1) */
 	case '\017': /* SI (LS0 -- Locking shift 0) */
@@ -2729,7 +3512,7 @@ tcontrolcode(uchar ascii)
 	case 0x99:   /* TODO: SGCI */
 		break;
 	case 0x9a:   /* DECID -- Identify Terminal */
-		ttywrite(vtiden, sizeof(vtiden) - 1);
+		ttywrite(vtiden, strlen(vtiden));
 		break;
 	case 0x9b:   /* TODO: CSI */
 	case 0x9c:   /* TODO: ST */
@@ -2741,34 +3524,32 @@ tcontrolcode(uchar ascii)
 		tstrsequence(ascii);
 		return;
 	}
-	/* only CAN, SUB, \a and C1 chars interrupt a sequence */
-	term.esc &= ~(ESC_STR_END|ESC_STR);
 }
 
 /*
- * returns 1 when the sequence is finished and it hasn't to read
- * more characters for this sequence, otherwise 0
+ * sequences which need more characters set the state to continue in,
+ * otherwise the parser goes back to ground state
  */
-int
+void
 eschandle(uchar ascii)
 {
 	switch (ascii) {
 	case '[':
-		term.esc |= ESC_CSI;
-		return 0;
+		term.esc = ESC_CSI;
+		return;
 	case '#':
-		term.esc |= ESC_TEST;
-		return 0;
+		term.esc = ESC_TEST;
+		return;
 	case '%':
-		term.esc |= ESC_UTF8;
-		return 0;
+		term.esc = ESC_UTF8;
+		return;
 	case 'P': /* DCS -- Device Control String */
 	case '_': /* APC -- Application Program Command */
 	case '^': /* PM -- Privacy Message */
 	case ']': /* OSC -- Operating System Command */
 	case 'k': /* old title set compatibility */
 		tstrsequence(ascii);
-		return 0;
+		return;
 	case 'n': /* LS2 -- Locking shift 2 */
 	case 'o': /* LS3 -- Locking shift 3 */
 		term.charset = 2 + (ascii - 'n');
@@ -2778,8 +3559,8 @@ eschandle(uchar ascii)
 	case '*': /* G2D4 -- set tertiary charset G2 */
 	case '+': /* G3D4 -- set quaternary charset G3 */
 		term.icharset = ascii - '(';
-		term.esc |= ESC_ALTCHARSET;
-		return 0;
+		term.esc = ESC_ALTCHARSET;
+		return;
 	case 'D': /* IND -- Linefeed */
 		if (term.c.y == term.bot) {
 			tscrollup(term.top, 1);
@@ -2801,7 +3582,7 @@ eschandle(uchar ascii)
 		}
 		break;
 	case 'Z': /* DECID -- Identify Terminal */
-		ttywrite(vtiden, sizeof(vtiden) - 1);
+		ttywrite(vtiden, strlen(vtiden));
 		break;
 	case 'c': /* RIS -- Reset to inital state */
 		treset();
@@ -2820,16 +3601,74 @@ eschandle(uchar ascii)
 	case '8': /* DECRC -- Restore Cursor */
 		tcursor(CURSOR_LOAD);
 		break;
-	case '\\': /* ST -- String Terminator */
-		if (term.esc & ESC_STR_END)
-			strhandle();
+	case '\\': /* ST -- String Terminator without a string */
 		break;
 	default:
 		fprintf(stderr, "erresc: unknown sequence ESC 0x%02X '%c'\n",
 			(uchar) ascii, isprint(ascii)? ascii:'.');
 		break;
 	}
-	return 1;
+}
+
+/*
+ * Fast path for runs of printable ASCII outside of any sequence. As much
+ * of the run as fits before the wrap point is stored straight into the
+ * cursor line. Returns the number of runes consumed; 0 means the caller
+ * has to go through tputc().
+ */
+int
+tputascii(Rune *u, int len)
+{
+	int i, n, x = term.c.x, y = term.c.y;
+	LineInfo *li;
+	Glyph *gp;
+
+	if (term.esc || IS_SET(MODE_INSERT) || IS_SET(MODE_PRINT) ||
+	    (term.c.state & CURSOR_WRAPNEXT) ||
+	    term.trantbl[term.charset] == CS_GRAPHIC0)
+		return 0;
+
+	len = MIN(len, term.col - x);
+	for (n = 0; n < len && BETWEEN(u[n], ' ', '~'); n++)
+		/* nothing */ ;
+	if (n == 0)
+		return 0;
+
+	if (sel.ob.x != -1 && BETWEEN(y, sel.ob.y, sel.oe.y))
+		selclear();
+
+	gp = &term.line[y][x];
+	/* only the ends of the run can cut a wide char in half */
+	if (x > 0 && gp[0].mode & ATTR_WDUMMY) {
+		gp[-1].u = ' ';
+		gp[-1].mode &= ~ATTR_WIDE;
+	}
+	if ((gp[n-1].mode & ATTR_WIDE) && x+n < term.col) {
+		gp[n].u = ' ';
+		gp[n].mode &= ~ATTR_WDUMMY;
+	}
+
+	li = LINEINFO(term.line[y]);
+	for (i = 0; li->blink && i < n; i++)
+		li->blink -= !!(gp[i].mode & ATTR_BLINK);
+	if (term.c.attr.mode & ATTR_BLINK)
+		li->blink += n;
+
+	for (i = 0; i < n; i++) {
+		gp[i] = term.c.attr;
+		gp[i].u = u[i];
+	}
+	tsetdirtcols(y, x-1, x+n);
+	tlinechanged(term.line[y], MAX(x-1, 0), MIN(x+n, term.col-1));
+
+	if (x+n < term.col) {
+		term.c.x = x+n;
+	} else {
+		term.c.x = term.col-1;
+		term.c.state |= CURSOR_WRAPNEXT;
+	}
+
+	return n;
 }
 
 void
@@ -2837,16 +3676,16 @@ tputc(Rune u)
 {
 	char c[UTF_SIZ];
 	int control;
-	int width, len;
+	int width = 1, len = 1;
 	Glyph *gp;
+	Transition *t;
 
 	control = ISCONTROL(u);
 	if (!IS_SET(MODE_UTF8) && !IS_SET(MODE_SIXEL)) {
 		c[0] = u;
-		width = len = 1;
 	} else {
 		len = utf8encode(u, c);
-		if (!control && (width = wcwidth(u)) == -1) {
+		if (!control && (width = runewidth(u)) == -1) {
 			memcpy(c, "\357\277\275", 4); /* UTF_INVALID */
 			width = 1;
 		}
@@ -2856,109 +3695,94 @@ tputc(Rune u)
 		tprinter(c, len);
 
 	/*
-	 * STR sequence must be checked before anything else
-	 * because it uses all following characters until it
-	 * receives a ESC, a SUB, a ST or any other C1 control
-	 * character.
+	 * Actions of control codes must be performed as soon they arrive
+	 * because they can be embedded inside a control sequence, and
+	 * they must not cause conflicts with sequences. The transition
+	 * table takes care of that, see esctrans.
 	 */
-	if (term.esc & ESC_STR) {
-		if (u == '\a' || u == 030 || u == 032 || u == 033 ||
-		    ISCONTROLC1(u)) {
-			term.esc &= ~(ESC_START|ESC_STR|ESC_DCS);
-			if (IS_SET(MODE_SIXEL)) {
-				/* TODO: render sixel */;
-				term.mode &= ~MODE_SIXEL;
-				return;
-			}
-			term.esc |= ESC_STR_END;
-			goto check_control_code;
-		}
-
+	t = &esctrans[term.esc][(u < 0x80) ? escclass[u] :
+	                        ISCONTROLC1(u) ? CLASS_C1 : CLASS_HIGH];
+	term.esc = t->next;
 
+	switch (t->action) {
+	case ACT_PRINT:
+		break;
+	case ACT_EXECUTE:
+		tcontrolcode(u);
+		return;
+	case ACT_ESCDISPATCH:
+		eschandle(u);
+		return;
+	case ACT_CSIPUT:
+		csiput(u);
+		return;
+	case ACT_CSIDISPATCH:
+		csiput(u);
+		LIMIT(csiescseq.narg, 1, ESC_ARG_SIZ);
+		csihandle();
+		return;
+	case ACT_STRPUT:
 		if (IS_SET(MODE_SIXEL)) {
 			/* TODO: implement sixel mode */
 			return;
 		}
-		if (term.esc&ESC_DCS && strescseq.len == 0 && u == 'q')
+		if (strescseq.type == 'P' && strescseq.len == 0 && u == 'q')
 			term.mode |= MODE_SIXEL;
 
-		if (strescseq.len+len >= sizeof(strescseq.buf)-1) {
-			/*
-			 * Here is a bug in terminals. If the user never sends
-			 * some code to stop the str or esc command, then st
-			 * will stop responding. But this is better than
-			 * silently failing with unknown characters. At least
-			 * then users will report back.
-			 *
-			 * In the case users ever get fixed, here is the code:
-			 */
-			/*
-			 * term.esc = 0;
-			 * strhandle();
-			 */
+		strput(c, len);
+		return;
+	case ACT_STREND:
+		if (IS_SET(MODE_SIXEL)) {
+			/* TODO: render sixel */;
+			term.mode &= ~MODE_SIXEL;
+			term.esc = ESC_GROUND;
 			return;
 		}
-
-		memmove(&strescseq.buf[strescseq.len], c, len);
-		strescseq.len += len;
-		return;
-	}
-
-check_control_code:
-	/*
-	 * Actions of control codes must be performed as soon they arrive
-	 * because they can be embedded inside a control sequence, and
-	 * they must not cause conflicts with sequences.
-	 */
-	if (control) {
-		tcontrolcode(u);
-		/*
-		 * control codes are not shown ever
-		 */
-		return;
-	} else if (term.esc & ESC_START) {
-		if (term.esc & ESC_CSI) {
-			csiescseq.buf[csiescseq.len++] = u;
-			if (BETWEEN(u, 0x40, 0x7E)
-					|| csiescseq.len >= \
-					sizeof(csiescseq.buf)-1) {
-				term.esc = 0;
-				csiparse();
-				csihandle();
-			}
-			return;
-		} else if (term.esc & ESC_UTF8) {
-			tdefutf8(u);
-		} else if (term.esc & ESC_ALTCHARSET) {
-			tdeftran(u);
-		} else if (term.esc & ESC_TEST) {
-			tdectest(u);
+		if (u == '\a') {
+			/* backwards compatibility to xterm */
+			strhandle();
 		} else {
-			if (!eschandle(u))
-				return;
-			/* sequence already finished */
+			tcontrolcode(u);
 		}
-		term.esc = 0;
-		/*
-		 * All characters which form part of a sequence are not
-		 * printed
-		 */
+		return;
+	case ACT_STRDISPATCH:
+		strhandle();
+		return;
+	case ACT_CHARSET:
+		tdeftran(u);
+		return;
+	case ACT_TEST:
+		tdectest(u);
+		return;
+	case ACT_UTF8:
+		tdefutf8(u);
 		return;
 	}
+
 	if (sel.ob.x != -1 && BETWEEN(term.c.y, sel.ob.y, sel.oe.y))
 		selclear();
 
 	gp = &term.line[term.c.y][term.c.x];
 	if (IS_SET(MODE_WRAP) && (term.c.state & CURSOR_WRAPNEXT)) {
-		gp->mode |= ATTR_WRAP;
+		/* on the last cell, which is a wide char's dummy too */
+		term.line[term.c.y][term.col-1].mode |= ATTR_WRAP;
 		tnewline(1);
 		gp = &term.line[term.c.y][term.c.x];
 	}
 
-	if (IS_SET(MODE_INSERT) && term.c.x+width < term.col)
+	if (IS_SET(MODE_INSERT) && term.c.x+width < term.col) {
 		memmove(gp+width, gp, (term.col - term.c.x - width) * sizeof(Glyph));
+		tsetdirtcols(term.c.y, term.c.x, term.col-1);
+		if (LINEINFO(term.line[term.c.y])->blink)
+			tlineinfo(term.line[term.c.y], term.col);
+		else
+			tlinechanged(term.line[term.c.y], term.c.x, term.col-1);
+	}
 
 	if (term.c.x+width > term.col) {
+		/* the wide char leaves a blank that wraps */
+		tclearregion(term.c.x, term.c.y, term.col-1, term.c.y);
+		term.line[term.c.y][term.col-1].mode |= ATTR_WRAP;
 		tnewline(1);
 		gp = &term.line[term.c.y][term.c.x];
 	}
@@ -2968,8 +3792,11 @@ check_control_code:
 	if (width == 2) {
 		gp->mode |= ATTR_WIDE;
 		if (term.c.x+1 < term.col) {
+			if (gp[1].mode & ATTR_BLINK)
+				LINEINFO(term.line[term.c.y])->blink--;
 			gp[1].u = '\0';
 			gp[1].mode = ATTR_WDUMMY;
+			tlinechanged(term.line[term.c.y], term.c.x+1, term.c.x+1);
 		}
 	}
 	if (term.c.x+width < term.col) {
@@ -2979,14 +3806,163 @@ check_control_code:
 	}
 }
 
+/*
+ * A screen is a single slab of glyphs, its rows GRID_ALIGN aligned and
+ * starting with the LineInfo, and the ring of pointers to them. The
+ * nline surviving lines of ncol cells are copied over in screen order,
+ * which also unrolls the ring. The others are to be cleared.
+ */
+void
+tresizegrid(Glyph **grid, Line **ring, Line *line, int nline, int ncol,
+            int col, int row)
+{
+	size_t info = DIVCEIL(sizeof(LineInfo), sizeof(Glyph));
+	size_t stride = DIVCEIL((info + col) * sizeof(Glyph), GRID_ALIGN)
+	                * GRID_ALIGN / sizeof(Glyph);
+	int i, n = MIN(row, nline), mincol = MIN(col, ncol);
+	Glyph *g = xmemalign(GRID_ALIGN, row * stride * sizeof(Glyph));
+	Line *r = xmalloc(2 * row * sizeof(Line));
+
+	for (i = 0; i < row; i++) {
+		r[i] = r[i + row] = g + i * stride + info;
+		*LINEINFO(r[i]) = (LineInfo){ 0 };
+		if (i < n) {
+			memcpy(r[i], line[i], mincol * sizeof(Glyph));
+			tlineinfo(r[i], mincol);
+		}
+	}
+	free(*grid);
+	free(*ring);
+	*grid = g;
+	*ring = r;
+}
+
+void
+tflow(Flow *f, Glyph *g, int n)
+{
+	Glyph *end = g + n, pad;
+	int y;
+
+	for (; g < end; g++) {
+		/* the padding a wide char left goes, another blank stays */
+		if (f->pad.mode && !(g->mode & ATTR_WIDE)) {
+			pad = f->pad;
+			pad.mode = 0;
+			f->pad.mode = 0;
+			tflow(f, &pad, 1);
+		}
+		f->pad.mode = 0;
+		if (g->u == ' ' && g->mode == ATTR_WRAP) {
+			f->pad = *g;
+			continue;
+		}
+		/* a wide char does not straddle rows */
+		if (f->x == f->col || (g->mode & ATTR_WIDE && f->x > 0
+				&& f->x == f->col - 1)) {
+			y = f->y - f->y0;
+			if (y >= 0 && y < f->nout)
+				f->out[y][f->col-1].mode |= ATTR_WRAP;
+			f->y++;
+			f->x = 0;
+		}
+		y = f->y - f->y0;
+		if (y >= 0 && y < f->nout) {
+			f->out[y][f->x] = *g;
+			f->out[y][f->x].mode &= ~ATTR_WRAP;
+		}
+		f->x++;
+	}
+}
+
+/*
+ * Rewrap the main screen to col columns, joining the lines it wrapped.
+ * The rows that do not fit above the cursor any more go to the history.
+ * Returns whether the cursor waits to wrap.
+ */
+int
+treflow(int col, int row)
+{
+	Glyph blank = { .u = ' ', .style = tstyle(defaultfg, defaultbg) };
+	Flow f;
+	Glyph *g = NULL, *head = NULL;
+	Line *out = NULL, line;
+	int i, y, n, nhead, last, cx = 0, cy = 0, top = 0, nout = 0;
+	int wrapnext = term.c.state & CURSOR_WRAPNEXT;
+
+	selclear();
+	for (last = term.row - 1; last > term.c.y; last--) {
+		if (tlinetrim(term.line[last], term.col))
+			break;
+	}
+	/* the history is laid out again from scratch */
+	nhead = histtake(&head);
+	hist.vcol = hist.tail.col = 0;
+
+	/* count the rows first, then lay them out */
+	for (;;) {
+		f = (Flow){ .col = col, .out = out, .nout = nout };
+		tflow(&f, head, nhead);
+		for (y = 0; y <= last; y++) {
+			line = term.line[y];
+			if (y > 0 && !(term.line[y-1][term.col-1].mode
+					& ATTR_WRAP)) {
+				f.y++;
+				f.x = 0;
+				f.pad.mode = 0;
+			}
+			if (line[term.col-1].mode & ATTR_WRAP)
+				n = term.col;
+			else
+				n = tlinetrim(line, term.col);
+			if (y == term.c.y) {
+				n = MAX(n, term.c.x + 1);
+				tflow(&f, line, term.c.x + 1);
+				cx = f.x - 1;
+				cy = f.y;
+				line += term.c.x + 1;
+				n -= term.c.x + 1;
+			}
+			tflow(&f, line, n);
+		}
+		if (out)
+			break;
+
+		top = MAX(cy - row + 1, 0);
+		nout = top + row;
+		g = xmalloc(nout * col * sizeof(*g));
+		out = xmalloc(nout * sizeof(*out));
+		for (i = 0; i < nout * col; i++)
+			g[i] = blank;
+		for (i = 0; i < nout; i++)
+			out[i] = g + i * col;
+	}
+
+	tresizegrid(&term.grid, &term.ring, out + top, row, col, col, row);
+	for (y = 0; y < top; y++)
+		histpush(out[y], col);
+	free(head);
+	free(g);
+	free(out);
+
+	if (wrapnext && cx < col - 1) {
+		cx++;
+		wrapnext = 0;
+	}
+	term.c.x = cx;
+	term.c.y = cy - top;
+
+	return wrapnext;
+}
+
 void
 tresize(int col, int row)
 {
-	int i;
+	int i, shift, reflow, wrapnext = 0;
 	int minrow = MIN(row, term.row);
 	int mincol = MIN(col, term.col);
 	int *bp;
 	TCursor c;
+	Line *screen;
 
 	if (col < 1 || row < 1) {
 		fprintf(stderr,
@@ -2995,41 +3971,33 @@ tresize(int col, int row)
 	}
 
 	/*
-	 * slide screen to keep cursor where we expect it -
-	 * tscrollup would work here, but we can optimize to
-	 * memmove because we're freeing the earlier lines
+	 * slide screen to keep cursor where we expect it, the lines
+	 * dropped from the top of the main screen go to the history.
+	 * When the width changes the main screen is rewrapped instead,
+	 * if it is shown.
 	 */
-	for (i = 0; i <= term.c.y - row; i++) {
-		free(term.line[i]);
-		free(term.alt[i]);
-	}
-	/* ensure that both src and dst are not NULL */
-	if (i > 0) {
-		memmove(term.line, term.line + i, row * sizeof(Line));
-		memmove(term.alt, term.alt + i, row * sizeof(Line));
-	}
-	for (i += row; i < term.row; i++) {
-		free(term.line[i]);
-		free(term.alt[i]);
-	}
+	shift = MAX(term.c.y - row + 1, 0);
+	term.scroll = 0;
+	reflow = !IS_SET(MODE_ALTSCREEN) && term.col && col != term.col;
+	if (reflow) {
+		wrapnext = treflow(col, row);
+	} else {
+		screen = IS_SET(MODE_ALTSCREEN) ? term.alt : term.line;
+		for (i = 0; i < shift; i++)
+			histpush(screen[i], term.col);
+		tresizegrid(&term.grid, &term.ring, term.line + shift,
+		            term.row - shift, term.col, col, row);
+	}
+	tresizegrid(&term.altgrid, &term.altring, term.alt + shift,
+	            term.row - shift, term.col, col, row);
+	term.line = term.ring;
+	term.alt = term.altring;
+	tresizegrid(&term.histgrid, &term.hist, term.hist, term.row, term.col,
+	            col, row);
 
-	/* resize to new height */
-	term.line = xrealloc(term.line, row * sizeof(Line));
-	term.alt  = xrealloc(term.alt,  row * sizeof(Line));
 	term.dirty = xrealloc(term.dirty, row * sizeof(*term.dirty));
 	term.tabs = xrealloc(term.tabs, col * sizeof(*term.tabs));
 
-	/* resize each row to new width, zero-pad if needed */
-	for (i = 0; i < minrow; i++) {
-		term.line[i] = xrealloc(term.line[i], col * sizeof(Glyph));
-		term.alt[i]  = xrealloc(term.alt[i],  col * sizeof(Glyph));
-	}
-
-	/* allocate any new rows */
-	for (/* i == minrow */; i < row; i++) {
-		term.line[i] = xmalloc(col * sizeof(Glyph));
-		term.alt[i] = xmalloc(col * sizeof(Glyph));
-	}
 	if (col > term.col) {
 		bp = term.tabs + term.col;
 
@@ -3042,17 +4010,21 @@ tresize(int col, int row)
 	/* update terminal size */
 	term.col = col;
 	term.row = row;
+	tfulldirt();
 	/* reset scrolling region */
 	tsetscroll(0, row-1);
 	/* make use of the LIMIT in tmoveto */
 	tmoveto(term.c.x, term.c.y);
+	if (wrapnext)
+		term.c.state |= CURSOR_WRAPNEXT;
 	/* Clearing both screens (it makes dirty all lines) */
 	c = term.c;
 	for (i = 0; i < 2; i++) {
-		if (mincol < col && 0 < minrow) {
+		/* a rewrapped screen has all its rows laid out already */
+		if (mincol < col && 0 < minrow && (i || !reflow)) {
 			tclearregion(mincol, 0, col - 1, minrow - 1);
 		}
-		if (0 < col && minrow < row) {
+		if (0 < col && minrow < row && (i || !reflow)) {
 			tclearregion(0, minrow, col - 1, row - 1);
 		}
 		tswapscreen();
@@ -3061,1500 +4033,3 @@ tresize(int col, int row)
 	term.c = c;
 }
 
-void
-wlresize(int col, int row)
-{
-	union wld_object object;
-
-	wl.tw = MAX(1, col * wl.cw);
-	wl.th = MAX(1, row * wl.ch);
-
-	wld.oldbuffer = wld.buffer;
-	wld.buffer = wld_create_buffer(wld.ctx, wl.w, wl.h,
-			WLD_FORMAT_XRGB8888, 0);
-	wld_export(wld.buffer, WLD_WAYLAND_OBJECT_BUFFER, &object);
-	wl.buffer = object.ptr;
-}
-
-uchar
-sixd_to_8bit(int x)
-{
-	return x == 0 ? 0 : 0x37 + 0x28 * x;
-}
-
-int
-wlloadcolor(int i, const char *name, uint32_t *color)
-{
-	if (!name) {
-		if (BETWEEN(i, 16, 255)) { /* 256 color */
-			if (i < 6*6*6+16) { /* same colors as xterm */
-				*color = 0xff << 24 | sixd_to_8bit(((i-16)/36)%6) << 16
-					| sixd_to_8bit(((i-16)/6)%6) << 8
-					| sixd_to_8bit(((i-16)/1)%6);
-			} else { /* greyscale */
-				*color = 0xff << 24 | (0x8 + 0xa * (i-(6*6*6+16))) * 0x10101;
-			}
-			return true;
-		} else
-			name = colorname[i];
-	}
-
-	return wld_lookup_named_color(name, color);
-}
-
-void
-wlloadcols(void)
-{
-	int i;
-
-	for (i = 0; i < LEN(dc.col); i++)
-		if (!wlloadcolor(i, NULL, &dc.col[i])) {
-			if (colorname[i])
-				die("Could not allocate color '%s'\n", colorname[i]);
-			else
-				die("Could not allocate color %d\n", i);
-		}
-}
-
-int
-wlsetcolorname(int x, const char *name)
-{
-	uint32_t color;
-
-	if (!BETWEEN(x, 0, LEN(dc.col)))
-		return 1;
-
-	if (!wlloadcolor(x, name, &color))
-		return 1;
-
-	dc.col[x] = color;
-
-	return 0;
-}
-
-static void wlloadcursor(void)
-{
-	char *names[] = { mouseshape, "xterm", "ibeam", "text" };
-	int i;
-
-	cursor.theme = wl_cursor_theme_load(NULL, 32, wl.shm);
-
-	for (i = 0; !cursor.cursor && i < LEN(names); i++)
-		cursor.cursor = wl_cursor_theme_get_cursor(cursor.theme, names[i]);
-
-	cursor.surface = wl_compositor_create_surface(wl.cmp);
-}
-
-/*
- * Absolute coordinates.
- */
-void
-wlclear(int x1, int y1, int x2, int y2)
-{
-	uint32_t color = dc.col[IS_SET(MODE_REVERSE) ? defaultfg : defaultbg];
-
-	wld_fill_rectangle(wld.renderer, color, x1, y1, x2 - x1, y2 - y1);
-}
-
-int
-wlloadfont(Font *f, FcPattern *pattern)
-{
-	FcPattern *configured;
-	FcPattern *match;
-	FcResult result;
-	struct wld_extents extents;
-	int wantattr, haveattr;
-
-	/*
-	 * Manually configure instead of calling XftMatchFont
-	 * so that we can use the configured pattern for
-	 * "missing glyph" lookups.
-	 */
-	configured = FcPatternDuplicate(pattern);
-	if (!configured)
-		return 1;
-
-	FcConfigSubstitute(NULL, configured, FcMatchPattern);
-	FcDefaultSubstitute(configured);
-
-	match = FcFontMatch(NULL, configured, &result);
-	if (!match) {
-		FcPatternDestroy(configured);
-		return 1;
-	}
-
-	if (!(f->match = wld_font_open_pattern(wld.fontctx, match))) {
-		FcPatternDestroy(configured);
-		FcPatternDestroy(match);
-		return 1;
-	}
-
-	if ((FcPatternGetInteger(pattern, "slant", 0, &wantattr) ==
-	    FcResultMatch)) {
-		/*
-		 * Check if xft was unable to find a font with the appropriate
-		 * slant but gave us one anyway. Try to mitigate.
-		 */
-		if ((FcPatternGetInteger(match, "slant", 0,
-		    &haveattr) != FcResultMatch) || haveattr < wantattr) {
-			f->badslant = 1;
-			fputs("st: font slant does not match\n", stderr);
-		}
-	}
-
-	if ((FcPatternGetInteger(pattern, "weight", 0, &wantattr) ==
-	    FcResultMatch)) {
-		if ((FcPatternGetInteger(match, "weight", 0,
-		    &haveattr) != FcResultMatch) || haveattr != wantattr) {
-			f->badweight = 1;
-			fputs("st: font weight does not match\n", stderr);
-		}
-	}
-
-
-	wld_font_text_extents(f->match, ascii_printable, &extents);
-
-	f->set = NULL;
-	f->pattern = configured;
-
-	f->ascent = f->match->ascent;
-	f->descent = f->match->descent;
-	f->lbearing = 0;
-	f->rbearing = f->match->max_advance;
-
-	f->height = f->ascent + f->descent;
-	f->width = DIVCEIL(extents.advance, strlen(ascii_printable));
-
-	return 0;
-}
-
-void
-wlloadfonts(char *fontstr, double fontsize)
-{
-	FcPattern *pattern;
-	double fontval;
-	float ceilf(float);
-
-	if (fontstr[0] == '-') {
-		/* XXX: need XftXlfdParse equivalent */
-		pattern = NULL;
-	} else {
-		pattern = FcNameParse((FcChar8 *)fontstr);
-	}
-
-	if (!pattern)
-		die("st: can't open font %s\n", fontstr);
-
-	if (fontsize > 1) {
-		FcPatternDel(pattern, FC_PIXEL_SIZE);
-		FcPatternDel(pattern, FC_SIZE);
-		FcPatternAddDouble(pattern, FC_PIXEL_SIZE, (double)fontsize);
-		usedfontsize = fontsize;
-	} else {
-		if (FcPatternGetDouble(pattern, FC_PIXEL_SIZE, 0, &fontval) ==
-				FcResultMatch) {
-			usedfontsize = fontval;
-		} else if (FcPatternGetDouble(pattern, FC_SIZE, 0, &fontval) ==
-				FcResultMatch) {
-			usedfontsize = -1;
-		} else {
-			/*
-			 * Default font size is 12, if none given. This is to
-			 * have a known usedfontsize value.
-			 */
-			FcPatternAddDouble(pattern, FC_PIXEL_SIZE, 12);
-			usedfontsize = 12;
-		}
-		defaultfontsize = usedfontsize;
-	}
-
-	FcConfigSubstitute(0, pattern, FcMatchPattern);
-	FcDefaultSubstitute(pattern);
-
-	if (wlloadfont(&dc.font, pattern))
-		die("st: can't open font %s\n", fontstr);
-
-	if (usedfontsize < 0) {
-		FcPatternGetDouble(dc.font.pattern,
-		                   FC_PIXEL_SIZE, 0, &fontval);
-		usedfontsize = fontval;
-		if (fontsize == 0)
-			defaultfontsize = fontval;
-	}
-
-	/* Setting character width and height. */
-	wl.cw = ceilf(dc.font.width * cwscale);
-	wl.ch = ceilf(dc.font.height * chscale);
-
-	FcPatternDel(pattern, FC_SLANT);
-	FcPatternAddInteger(pattern, FC_SLANT, FC_SLANT_ITALIC);
-	if (wlloadfont(&dc.ifont, pattern))
-		die("st: can't open font %s\n", fontstr);
-
-	FcPatternDel(pattern, FC_WEIGHT);
-	FcPatternAddInteger(pattern, FC_WEIGHT, FC_WEIGHT_BOLD);
-	if (wlloadfont(&dc.ibfont, pattern))
-		die("st: can't open font %s\n", fontstr);
-
-	FcPatternDel(pattern, FC_SLANT);
-	FcPatternAddInteger(pattern, FC_SLANT, FC_SLANT_ROMAN);
-	if (wlloadfont(&dc.bfont, pattern))
-		die("st: can't open font %s\n", fontstr);
-
-	FcPatternDestroy(pattern);
-}
-
-void
-wlunloadfont(Font *f)
-{
-	wld_font_close(f->match);
-	FcPatternDestroy(f->pattern);
-	if (f->set)
-		FcFontSetDestroy(f->set);
-}
-
-void
-wlunloadfonts(void)
-{
-	/* Free the loaded fonts in the font cache.  */
-	while (frclen > 0)
-		wld_font_close(frc[--frclen].font);
-
-	wlunloadfont(&dc.font);
-	wlunloadfont(&dc.bfont);
-	wlunloadfont(&dc.ifont);
-	wlunloadfont(&dc.ibfont);
-}
-
-void
-wlzoom(const Arg *arg)
-{
-	Arg larg;
-
-	larg.f = usedfontsize + arg->f;
-	wlzoomabs(&larg);
-}
-
-void
-wlzoomabs(const Arg *arg)
-{
-	wlunloadfonts();
-	wlloadfonts(usedfont, arg->f);
-	cresize(0, 0);
-	ttyresize();
-	redraw();
-	/* XXX: Should the window size be updated here because wayland doesn't
-	 * have a notion of hints?
-	 * xhints();
-	 */
-}
-
-void
-wlzoomreset(const Arg *arg)
-{
-	Arg larg;
-
-	if (defaultfontsize > 0) {
-		larg.f = defaultfontsize;
-		wlzoomabs(&larg);
-	}
-}
-
-void
-wlinit(void)
-{
-	struct wl_registry *registry;
-
-	if (!(wl.dpy = wl_display_connect(NULL)))
-		die("Can't open display\n");
-
-	registry = wl_display_get_registry(wl.dpy);
-	wl_registry_add_listener(registry, &reglistener, NULL);
-	wld.ctx = wld_wayland_create_context(wl.dpy, WLD_ANY);
-	wld.renderer = wld_create_renderer(wld.ctx);
-
-	wl_display_roundtrip(wl.dpy);
-
-	if (!wl.shm)
-		die("Display has no SHM\n");
-	if (!wl.seat)
-		die("Display has no seat\n");
-	if (!wl.datadevmanager)
-		die("Display has no data device manager\n");
-
-	wl.keyboard = wl_seat_get_keyboard(wl.seat);
-	wl_keyboard_add_listener(wl.keyboard, &kbdlistener, NULL);
-	wl.pointer = wl_seat_get_pointer(wl.seat);
-	wl_pointer_add_listener(wl.pointer, &ptrlistener, NULL);
-	wl.datadev = wl_data_device_manager_get_data_device(wl.datadevmanager,
-			wl.seat);
-	wl_data_device_add_listener(wl.datadev, &datadevlistener, NULL);
-
-	/* font */
-	if (!FcInit())
-		die("Could not init fontconfig.\n");
-
-	usedfont = (opt_font == NULL)? font : opt_font;
-	wld.fontctx = wld_font_create_context();
-	wlloadfonts(usedfont, 0);
-
-	wlloadcols();
-	wlloadcursor();
-
-	wl.vis = 0;
-	wl.h = 2 * borderpx + term.row * wl.ch;
-	wl.w = 2 * borderpx + term.col * wl.cw;
-
-	wl.surface = wl_compositor_create_surface(wl.cmp);
-	wl_surface_add_listener(wl.surface, &surflistener, NULL);
-
-	wl.xdgsurface = xdg_shell_get_xdg_surface(wl.shell, wl.surface);
-	xdg_surface_add_listener(wl.xdgsurface, &xdgsurflistener, NULL);
-	xdg_surface_set_app_id(wl.xdgsurface, opt_class ? opt_class : termname);
-
-	wl.xkb.ctx = xkb_context_new(0);
-	wlresettitle();
-}
-
-/*
- * TODO: Implement something like XftDrawGlyphFontSpec in wld, and then apply a
- * similar patch to ae1923d27533ff46400d93765e971558201ca1ee
- */
-
-void
-wldraws(char *s, Glyph base, int x, int y, int charlen, int bytelen)
-{
-	int winx = borderpx + x * wl.cw, winy = borderpx + y * wl.ch,
-	    width = charlen * wl.cw, xp, i;
-	int frcflags, charexists;
-	int u8fl, u8fblen, u8cblen, doesexist;
-	char *u8c, *u8fs;
-	Rune unicodep;
-	Font *font = &dc.font;
-	FcResult fcres;
-	FcPattern *fcpattern, *fontpattern;
-	FcFontSet *fcsets[] = { NULL };
-	FcCharSet *fccharset;
-	uint32_t fg, bg, temp;
-	int oneatatime;
-
-	frcflags = FRC_NORMAL;
-
-	/* Fallback on color display for attributes not supported by the font */
-	if (base.mode & ATTR_ITALIC && base.mode & ATTR_BOLD) {
-		if (dc.ibfont.badslant || dc.ibfont.badweight)
-			base.fg = defaultattr;
-		font = &dc.ibfont;
-		frcflags = FRC_ITALICBOLD;
-	} else if (base.mode & ATTR_ITALIC) {
-		if (dc.ifont.badslant)
-			base.fg = defaultattr;
-		font = &dc.ifont;
-		frcflags = FRC_ITALIC;
-	} else if (base.mode & ATTR_BOLD) {
-		if (dc.bfont.badweight)
-			base.fg = defaultattr;
-		font = &dc.ifont;
-		frcflags = FRC_BOLD;
-	}
-
-	if (IS_TRUECOL(base.fg)) {
-		fg = base.fg | 0xff000000;
-	} else {
-		fg = dc.col[base.fg];
-	}
-
-	if (IS_TRUECOL(base.bg)) {
-		bg = base.bg | 0xff000000;
-	} else {
-		bg = dc.col[base.bg];
-	}
-
-	if (base.mode & ATTR_BOLD) {
-		/*
-		 * change basic system colors [0-7]
-		 * to bright system colors [8-15]
-		 */
-		if (BETWEEN(base.fg, 0, 7) && !(base.mode & ATTR_FAINT))
-			fg = dc.col[base.fg + 8];
-
-		if (base.mode & ATTR_ITALIC) {
-			font = &dc.ibfont;
-			frcflags = FRC_ITALICBOLD;
-		} else {
-			font = &dc.bfont;
-			frcflags = FRC_BOLD;
-		}
-	}
-
-	if (IS_SET(MODE_REVERSE)) {
-		if (fg == dc.col[defaultfg]) {
-			fg = dc.col[defaultbg];
-		} else {
-			fg = ~(fg & 0xffffff);
-		}
-
-		if (bg == dc.col[defaultbg]) {
-			bg = dc.col[defaultfg];
-		} else {
-			bg = ~(bg & 0xffffff);
-		}
-	}
-
-	if (base.mode & ATTR_REVERSE) {
-		temp = fg;
-		fg = bg;
-		bg = temp;
-	}
-
-	if (base.mode & ATTR_FAINT && !(base.mode & ATTR_BOLD)) {
-		fg = (fg & (0xff << 24))
-			| ((((fg >> 16) & 0xff) / 2) << 16)
-			| ((((fg >> 8) & 0xff) / 2) << 8)
-			| ((fg & 0xff) / 2);
-	}
-
-	if (base.mode & ATTR_BLINK && term.mode & MODE_BLINK)
-		fg = bg;
-
-	if (base.mode & ATTR_INVISIBLE)
-		fg = bg;
-
-	/* Intelligent cleaning up of the borders. */
-	if (x == 0) {
-		wlclear(0, (y == 0)? 0 : winy, borderpx,
-			((y >= term.row-1)? wl.h : (winy + wl.ch)));
-	}
-	if (x + charlen >= term.col) {
-		wlclear(winx + width, (y == 0)? 0 : winy, wl.w,
-			((y >= term.row-1)? wl.h : (winy + wl.ch)));
-	}
-	if (y == 0)
-		wlclear(winx, 0, winx + width, borderpx);
-	if (y == term.row-1)
-		wlclear(winx, winy + wl.ch, winx + width, wl.h);
-
-	/* Clean up the region we want to draw to. */
-	wld_fill_rectangle(wld.renderer, bg, winx, winy, width, wl.ch);
-
-	for (xp = winx; bytelen > 0;) {
-		/*
-		 * Search for the range in the to be printed string of glyphs
-		 * that are in the main font. Then print that range. If
-		 * some glyph is found that is not in the font, do the
-		 * fallback dance.
-		 */
-		u8fs = s;
-		u8fblen = 0;
-		u8fl = 0;
-		oneatatime = font->width != wl.cw;
-		for (;;) {
-			u8c = s;
-			u8cblen = utf8decode(s, &unicodep, UTF_SIZ);
-			s += u8cblen;
-			bytelen -= u8cblen;
-
-			doesexist = wld_font_ensure_char(font->match, unicodep);
-			if (doesexist) {
-					u8fl++;
-					u8fblen += u8cblen;
-					if (!oneatatime && bytelen > 0)
-							continue;
-			}
-
-			if (u8fl > 0) {
-				wld_draw_text(wld.renderer,
-						font->match, fg, xp,
-						winy + font->ascent,
-						u8fs, u8fblen, NULL);
-				xp += wl.cw * u8fl;
-			}
-			break;
-		}
-		if (doesexist) {
-			if (oneatatime)
-				continue;
-			break;
-		}
-
-		/* Search the font cache. */
-		for (i = 0; i < frclen; i++) {
-			charexists = wld_font_ensure_char(frc[i].font, unicodep);
-			/* Everything correct. */
-			if (charexists && frc[i].flags == frcflags)
-				break;
-			/* We got a default font for a not found glyph. */
-			if (!charexists && frc[i].flags == frcflags \
-					&& frc[i].unicodep == unicodep) {
-				break;
-			}
-		}
-
-		/* Nothing was found. */
-		if (i >= frclen) {
-			if (!font->set)
-				font->set = FcFontSort(0, font->pattern,
-				                       1, 0, &fcres);
-			fcsets[0] = font->set;
-
-			/*
-			 * Nothing was found in the cache. Now use
-			 * some dozen of Fontconfig calls to get the
-			 * font for one single character.
-			 *
-			 * Xft and fontconfig are design failures.
-			 */
-			fcpattern = FcPatternDuplicate(font->pattern);
-			fccharset = FcCharSetCreate();
-
-			FcCharSetAddChar(fccharset, unicodep);
-			FcPatternAddCharSet(fcpattern, FC_CHARSET,
-					fccharset);
-			FcPatternAddBool(fcpattern, FC_SCALABLE, 1);
-
-			FcConfigSubstitute(0, fcpattern,
-					FcMatchPattern);
-			FcDefaultSubstitute(fcpattern);
-
-			fontpattern = FcFontSetMatch(0, fcsets, 1,
-					fcpattern, &fcres);
-
-			/*
-			 * Overwrite or create the new cache entry.
-			 */
-			if (frclen >= LEN(frc)) {
-				frclen = LEN(frc) - 1;
-				wld_font_close(frc[frclen].font);
-				frc[frclen].unicodep = 0;
-			}
-
-			frc[frclen].font = wld_font_open_pattern(wld.fontctx,
-					fontpattern);
-			frc[frclen].flags = frcflags;
-			frc[frclen].unicodep = unicodep;
-
-			i = frclen;
-			frclen++;
-
-			FcPatternDestroy(fcpattern);
-			FcCharSetDestroy(fccharset);
-		}
-
-		wld_draw_text(wld.renderer, frc[i].font, fg,
-				xp, winy + frc[i].font->ascent,
-				u8c, u8cblen, NULL);
-
-		xp += wl.cw * wcwidth(unicodep);
-	}
-
-	if (base.mode & ATTR_UNDERLINE) {
-		wld_fill_rectangle(wld.renderer, fg, winx, winy + font->ascent + 1,
-				width, 1);
-	}
-
-	if (base.mode & ATTR_STRUCK) {
-		wld_fill_rectangle(wld.renderer, fg, winx, winy + 2 * font->ascent / 3,
-				width, 1);
-	}
-}
-
-void
-wldrawglyph(Glyph g, int x, int y)
-{
-	static char buf[UTF_SIZ];
-	size_t len = utf8encode(g.u, buf);
-	int width = g.mode & ATTR_WIDE ? 2 : 1;
-
-	wldraws(buf, g, x, y, width, len);
-}
-
-void
-wldrawcursor(void)
-{
-	static int oldx = 0, oldy = 0;
-	int curx;
-	Glyph g = {' ', ATTR_NULL, defaultbg, defaultcs}, og;
-	int ena_sel = sel.ob.x != -1 && sel.alt == IS_SET(MODE_ALTSCREEN);
-	uint32_t drawcol;
-
-	LIMIT(oldx, 0, term.col-1);
-	LIMIT(oldy, 0, term.row-1);
-
-	curx = term.c.x;
-
-	/* adjust position if in dummy */
-	if (term.line[oldy][oldx].mode & ATTR_WDUMMY)
-		oldx--;
-	if (term.line[term.c.y][curx].mode & ATTR_WDUMMY)
-		curx--;
-
-	/* remove the old cursor */
-	og = term.line[oldy][oldx];
-	if (ena_sel && selected(oldx, oldy))
-		og.mode ^= ATTR_REVERSE;
-	wldrawglyph(og, oldx, oldy);
-	if (oldx != curx || oldy != term.c.y) {
-		wl_surface_damage(wl.surface, borderpx + oldx * wl.cw,
-				borderpx + oldy * wl.ch, wl.cw, wl.ch);
-	}
-
-	g.u = term.line[term.c.y][term.c.x].u;
-
-	/*
-	 * Select the right color for the right mode.
-	 */
-	if (IS_SET(MODE_REVERSE)) {
-		g.mode |= ATTR_REVERSE;
-		g.bg = defaultfg;
-		if (ena_sel && selected(term.c.x, term.c.y)) {
-			drawcol = dc.col[defaultcs];
-			g.fg = defaultrcs;
-		} else {
-			drawcol = dc.col[defaultrcs];
-			g.fg = defaultcs;
-		}
-	} else {
-		if (ena_sel && selected(term.c.x, term.c.y)) {
-			drawcol = dc.col[defaultrcs];
-			g.fg = defaultfg;
-			g.bg = defaultrcs;
-		} else {
-			drawcol = dc.col[defaultcs];
-		}
-	}
-
-	if (IS_SET(MODE_HIDE))
-		return;
-
-	/* draw the new one */
-	if (wl.state & WIN_FOCUSED) {
-		switch (wl.cursor) {
-		case 7: /* st extension: snowman */
-			utf8decode("☃", &g.u, UTF_SIZ);
-		case 0: /* Blinking Block */
-		case 1: /* Blinking Block (Default) */
-		case 2: /* Steady Block */
-			g.mode |= term.line[term.c.y][curx].mode & ATTR_WIDE;
-			wldrawglyph(g, term.c.x, term.c.y);
-			break;
-		case 3: /* Blinking Underline */
-		case 4: /* Steady Underline */
-			wld_fill_rectangle(wld.renderer, drawcol,
-					borderpx + curx * wl.cw,
-					borderpx + (term.c.y + 1) * wl.ch - \
-						cursorthickness,
-					wl.cw, cursorthickness);
-			break;
-		case 5: /* Blinking bar */
-		case 6: /* Steady bar */
-			wld_fill_rectangle(wld.renderer, drawcol,
-					borderpx + curx * wl.cw,
-					borderpx + term.c.y * wl.ch,
-					cursorthickness, wl.ch);
-			break;
-		}
-	} else {
-		wld_fill_rectangle(wld.renderer, drawcol,
-				borderpx + curx * wl.cw,
-				borderpx + term.c.y * wl.ch,
-				wl.cw - 1, 1);
-		wld_fill_rectangle(wld.renderer, drawcol,
-				borderpx + curx * wl.cw,
-				borderpx + term.c.y * wl.ch,
-				1, wl.ch - 1);
-		wld_fill_rectangle(wld.renderer, drawcol,
-				borderpx + (curx + 1) * wl.cw - 1,
-				borderpx + term.c.y * wl.ch,
-				1, wl.ch - 1);
-		wld_fill_rectangle(wld.renderer, drawcol,
-				borderpx + curx * wl.cw,
-				borderpx + (term.c.y + 1) * wl.ch - 1,
-				wl.cw, 1);
-	}
-	wl_surface_damage(wl.surface, borderpx + curx * wl.cw,
-			borderpx + term.c.y * wl.ch, wl.cw, wl.ch);
-	oldx = curx, oldy = term.c.y;
-}
-
-void
-wlsettitle(char *title)
-{
-	xdg_surface_set_title(wl.xdgsurface, title);
-}
-
-void
-wlresettitle(void)
-{
-	wlsettitle(opt_title ? opt_title : "st");
-}
-
-void
-redraw(void)
-{
-	tfulldirt();
-}
-
-void
-draw(void)
-{
-	int y, y0;
-
-	for (y = 0; y <= term.bot; ++y) {
-		if (!term.dirty[y])
-			continue;
-		for (y0 = y; y <= term.bot && term.dirty[y]; ++y);
-		wl_surface_damage(wl.surface, 0, borderpx + y0 * wl.ch,
-				wl.w, (y - y0) * wl.ch);
-	}
-
-	wld_set_target_buffer(wld.renderer, wld.buffer);
-	drawregion(0, 0, term.col, term.row);
-	wl.framecb = wl_surface_frame(wl.surface);
-	wl_callback_add_listener(wl.framecb, &framelistener, NULL);
-	wld_flush(wld.renderer);
-	wl_surface_attach(wl.surface, wl.buffer, 0, 0);
-	wl_surface_commit(wl.surface);
-	/* need to wait to destroy the old buffer until we commit the new
-	 * buffer */
-	if (wld.oldbuffer) {
-		wld_buffer_unreference(wld.oldbuffer);
-		wld.oldbuffer = 0;
-	}
-	needdraw = false;
-}
-
-void
-drawregion(int x1, int y1, int x2, int y2)
-{
-	int ic, ib, x, y, ox;
-	Glyph base, new;
-	char buf[DRAW_BUF_SIZ];
-	int ena_sel = sel.ob.x != -1 && sel.alt == IS_SET(MODE_ALTSCREEN);
-
-	for (y = y1; y < y2; y++) {
-		if (!term.dirty[y])
-			continue;
-
-		term.dirty[y] = 0;
-		base = term.line[y][0];
-		ic = ib = ox = 0;
-		for (x = x1; x < x2; x++) {
-			new = term.line[y][x];
-			if (new.mode == ATTR_WDUMMY)
-				continue;
-			if (ena_sel && selected(x, y))
-				new.mode ^= ATTR_REVERSE;
-			if (ib > 0 && (ATTRCMP(base, new)
-					|| ib >= DRAW_BUF_SIZ-UTF_SIZ)) {
-				wldraws(buf, base, ox, y, ic, ib);
-				ic = ib = 0;
-			}
-			if (ib == 0) {
-				ox = x;
-				base = new;
-			}
-
-			ib += utf8encode(new.u, buf+ib);
-			ic += (new.mode & ATTR_WIDE)? 2 : 1;
-		}
-		if (ib > 0)
-			wldraws(buf, base, ox, y, ic, ib);
-	}
-	wldrawcursor();
-}
-
-void
-wlseturgency(int add)
-{
-	/* XXX: no urgency equivalent yet in wayland */
-}
-
-int
-match(uint mask, uint state)
-{
-	return mask == MOD_MASK_ANY || mask == (state & ~(ignoremod));
-}
-
-void
-numlock(const Arg *dummy)
-{
-	term.numlock ^= 1;
-}
-
-char*
-kmap(xkb_keysym_t k, uint state)
-{
-	Key *kp;
-	int i;
-
-	/* Check for mapped keys out of X11 function keys. */
-	for (i = 0; i < LEN(mappedkeys); i++) {
-		if (mappedkeys[i] == k)
-			break;
-	}
-	if (i == LEN(mappedkeys)) {
-		if ((k & 0xFFFF) < 0xFD00)
-			return NULL;
-	}
-
-	for (kp = key; kp < key + LEN(key); kp++) {
-		if (kp->k != k)
-			continue;
-
-		if (!match(kp->mask, state))
-			continue;
-
-		if (IS_SET(MODE_APPKEYPAD) ? kp->appkey < 0 : kp->appkey > 0)
-			continue;
-		if (term.numlock && kp->appkey == 2)
-			continue;
-
-		if (IS_SET(MODE_APPCURSOR) ? kp->appcursor < 0 : kp->appcursor > 0)
-			continue;
-
-		if (IS_SET(MODE_CRLF) ? kp->crlf < 0 : kp->crlf > 0)
-			continue;
-
-		return kp->s;
-	}
-
-	return NULL;
-}
-
-void
-cresize(int width, int height)
-{
-	int col, row;
-
-	if (width != 0)
-		wl.w = width;
-	if (height != 0)
-		wl.h = height;
-
-	col = (wl.w - 2 * borderpx) / wl.cw;
-	row = (wl.h - 2 * borderpx) / wl.ch;
-
-	tresize(col, row);
-	wlresize(col, row);
-}
-
-void
-regglobal(void *data, struct wl_registry *registry, uint32_t name,
-          const char *interface, uint32_t version)
-{
-	if (strcmp(interface, "wl_compositor") == 0) {
-		wl.cmp = wl_registry_bind(registry, name,
-				&wl_compositor_interface, 3);
-	} else if (strcmp(interface, "xdg_shell") == 0) {
-		wl.shell = wl_registry_bind(registry, name,
-				&xdg_shell_interface, 1);
-		xdg_shell_add_listener(wl.shell, &xdgshelllistener, NULL);
-		xdg_shell_use_unstable_version(wl.shell,
-				XDG_SHELL_VERSION_CURRENT);
-	} else if (strcmp(interface, "wl_shm") == 0) {
-		wl.shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
-	} else if (strcmp(interface, "wl_seat") == 0) {
-		wl.seat = wl_registry_bind(registry, name,
-				&wl_seat_interface, 4);
-	} else if (strcmp(interface, "wl_data_device_manager") == 0) {
-		wl.datadevmanager = wl_registry_bind(registry, name,
-				&wl_data_device_manager_interface, 1);
-	} else if (strcmp(interface, "wl_output") == 0) {
-		/* bind to outputs so we can get surface enter events */
-		wl_registry_bind(registry, name, &wl_output_interface, 2);
-	}
-}
-
-void
-regglobalremove(void *data, struct wl_registry *registry, uint32_t name)
-{
-}
-
-void
-surfenter(void *data, struct wl_surface *surface, struct wl_output *output)
-{
-	wl.vis++;
-	if (!(wl.state & WIN_VISIBLE))
-		wl.state |= WIN_VISIBLE;
-}
-
-void
-surfleave(void *data, struct wl_surface *surface, struct wl_output *output)
-{
-	if (--wl.vis == 0)
-		wl.state &= ~WIN_VISIBLE;
-}
-
-void
-framedone(void *data, struct wl_callback *callback, uint32_t msecs)
-{
-	wl_callback_destroy(callback);
-	wl.framecb = NULL;
-	if (needdraw && wl.state & WIN_VISIBLE) {
-		draw();
-	}
-}
-
-void
-kbdkeymap(void *data, struct wl_keyboard *keyboard, uint32_t format, int32_t fd,
-          uint32_t size)
-{
-	char *string;
-
-	if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1) {
-		close(fd);
-		return;
-	}
-
-	string = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
-
-	if (string == MAP_FAILED) {
-		close(fd);
-		return;
-	}
-
-	wl.xkb.keymap = xkb_keymap_new_from_string(wl.xkb.ctx, string,
-			XKB_KEYMAP_FORMAT_TEXT_V1, 0);
-	munmap(string, size);
-	close(fd);
-	wl.xkb.state = xkb_state_new(wl.xkb.keymap);
-
-	wl.xkb.ctrl = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_CTRL);
-	wl.xkb.alt = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_ALT);
-	wl.xkb.shift = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_SHIFT);
-	wl.xkb.logo = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_LOGO);
-
-	wl.xkb.mods = 0;
-}
-
-void
-kbdenter(void *data, struct wl_keyboard *keyboard, uint32_t serial,
-         struct wl_surface *surface, struct wl_array *keys)
-{
-	wl.state |= WIN_FOCUSED;
-	if (IS_SET(MODE_FOCUS))
-		ttywrite("\033[I", 3);
-	/* need to redraw the cursor */
-	needdraw = true;
-}
-
-void
-kbdleave(void *data, struct wl_keyboard *keyboard, uint32_t serial,
-	 struct wl_surface *surface)
-{
-	/* selection offers are invalidated when we lose keyboard focus */
-	wl.seloffer = NULL;
-	wl.state &= ~WIN_FOCUSED;
-	if (IS_SET(MODE_FOCUS))
-		ttywrite("\033[O", 3);
-	/* need to redraw the cursor */
-	needdraw = true;
-	/* disable key repeat */
-	repeat.len = 0;
-}
-
-void
-kbdkey(void *data, struct wl_keyboard *keyboard, uint32_t serial, uint32_t time,
-       uint32_t key, uint32_t state)
-{
-	xkb_keysym_t ksym;
-	char buf[32], *str;
-	int len;
-	Rune c;
-	Shortcut *bp;
-
-	if (IS_SET(MODE_KBDLOCK))
-		return;
-
-	if (state == WL_KEYBOARD_KEY_STATE_RELEASED) {
-		if (repeat.key == key)
-			repeat.len = 0;
-		return;
-	}
-
-	ksym = xkb_state_key_get_one_sym(wl.xkb.state, key + 8);
-	len = xkb_keysym_to_utf8(ksym, buf, sizeof buf);
-	if (len > 0)
-	    --len;
-
-	/* 1. shortcuts */
-	for (bp = shortcuts; bp < shortcuts + LEN(shortcuts); bp++) {
-		if (ksym == bp->keysym && match(bp->mod, wl.xkb.mods)) {
-			bp->func(&(bp->arg));
-			return;
-		}
-	}
-
-	/* 2. custom keys from config.h */
-	if ((str = kmap(ksym, wl.xkb.mods))) {
-		len = strlen(str);
-		goto send;
-	}
-
-	/* 3. composed string from input method */
-	if (len == 0)
-		return;
-	if (len == 1 && wl.xkb.mods & MOD_MASK_ALT) {
-		if (IS_SET(MODE_8BIT)) {
-			if (*buf < 0177) {
-				c = *buf | 0x80;
-				len = utf8encode(c, buf);
-			}
-		} else {
-			buf[1] = buf[0];
-			buf[0] = '\033';
-			len = 2;
-		}
-	}
-	/* convert character to control character */
-	else if (len == 1 && wl.xkb.mods & MOD_MASK_CTRL) {
-		if ((*buf >= '@' && *buf < '\177') || *buf == ' ')
-			*buf &= 0x1F;
-		else if (*buf == '2') *buf = '\000';
-		else if (*buf >= '3' && *buf <= '7')
-			*buf -= ('3' - '\033');
-		else if (*buf == '8') *buf = '\177';
-		else if (*buf == '/') *buf = '_' & 0x1F;
-	}
-
-	str = buf;
-
-send:
-	memcpy(repeat.str, str, len);
-	repeat.key = key;
-	repeat.len = len;
-	repeat.started = false;
-	clock_gettime(CLOCK_MONOTONIC, &repeat.last);
-	ttysend(str, len);
-}
-
-void
-kbdmodifiers(void *data, struct wl_keyboard *keyboard, uint32_t serial,
-             uint32_t dep, uint32_t lat, uint32_t lck, uint32_t group)
-{
-	xkb_mod_mask_t mod_mask;
-
-	xkb_state_update_mask(wl.xkb.state, dep, lat, lck, group, 0, 0);
-
-	mod_mask = xkb_state_serialize_mods(wl.xkb.state, XKB_STATE_MODS_EFFECTIVE);
-	wl.xkb.mods = 0;
-
-	if (mod_mask & (1 << wl.xkb.ctrl))
-		wl.xkb.mods |= MOD_MASK_CTRL;
-	if (mod_mask & (1 << wl.xkb.alt))
-		wl.xkb.mods |= MOD_MASK_ALT;
-	if (mod_mask & (1 << wl.xkb.shift))
-		wl.xkb.mods |= MOD_MASK_SHIFT;
-	if (mod_mask & (1 << wl.xkb.logo))
-		wl.xkb.mods |= MOD_MASK_LOGO;
-}
-
-void
-kbdrepeatinfo(void *data, struct wl_keyboard *keyboard, int32_t rate,
-              int32_t delay)
-{
-	keyrepeatdelay = delay;
-	keyrepeatinterval = 1000 / rate;
-}
-
-void
-ptrenter(void *data, struct wl_pointer *pointer, uint32_t serial,
-         struct wl_surface *surface, wl_fixed_t x, wl_fixed_t y)
-{
-	struct wl_cursor_image *img = cursor.cursor->images[0];
-	struct wl_buffer *buffer;
-
-	wl_pointer_set_cursor(pointer, serial, cursor.surface,
-			img->hotspot_x, img->hotspot_y);
-	buffer = wl_cursor_image_get_buffer(img);
-	wl_surface_attach(cursor.surface, buffer, 0, 0);
-	wl_surface_damage(cursor.surface, 0, 0, img->width, img->height);
-	wl_surface_commit(cursor.surface);
-}
-
-void
-ptrleave(void *data, struct wl_pointer *pointer, uint32_t serial,
-         struct wl_surface *surface)
-{
-}
-
-void
-ptrmotion(void *data, struct wl_pointer * pointer, uint32_t serial,
-          wl_fixed_t x, wl_fixed_t y)
-{
-	int oldey, oldex, oldsby, oldsey;
-
-	if (IS_SET(MODE_MOUSE)) {
-		wlmousereportmotion(x, y);
-		return;
-	}
-
-	wl.px = wl_fixed_to_int(x);
-	wl.py = wl_fixed_to_int(y);
-
-	if (!sel.mode)
-		return;
-
-	sel.mode = SEL_READY;
-	oldey = sel.oe.y;
-	oldex = sel.oe.x;
-	oldsby = sel.nb.y;
-	oldsey = sel.ne.y;
-	getbuttoninfo();
-
-	if (oldey != sel.oe.y || oldex != sel.oe.x)
-		tsetdirt(MIN(sel.nb.y, oldsby), MAX(sel.ne.y, oldsey));
-}
-
-void
-ptrbutton(void * data, struct wl_pointer * pointer, uint32_t serial,
-          uint32_t time, uint32_t button, uint32_t state)
-{
-	MouseShortcut *ms;
-
-	if (IS_SET(MODE_MOUSE) && !(wl.xkb.mods & forceselmod)) {
-		wlmousereportbutton(button, state);
-		return;
-	}
-
-	switch (state) {
-	case WL_POINTER_BUTTON_STATE_RELEASED:
-		if (button == BTN_MIDDLE) {
-			selpaste(NULL);
-		} else if (button == BTN_LEFT) {
-			if (sel.mode == SEL_READY) {
-				getbuttoninfo();
-				selcopy(serial);
-			} else
-				selclear();
-			sel.mode = SEL_IDLE;
-			tsetdirt(sel.nb.y, sel.ne.y);
-		}
-		break;
-
-	case WL_POINTER_BUTTON_STATE_PRESSED:
-		for (ms = mshortcuts; ms < mshortcuts + LEN(mshortcuts); ms++) {
-			if (button == ms->b && match(ms->mask, wl.xkb.mods)) {
-				ttysend(ms->s, strlen(ms->s));
-				return;
-			}
-		}
-
-		if (button == BTN_LEFT) {
-			/* Clear previous selection, logically and visually. */
-			selclear();
-			sel.mode = SEL_EMPTY;
-			sel.type = SEL_REGULAR;
-			sel.oe.x = sel.ob.x = x2col(wl.px);
-			sel.oe.y = sel.ob.y = y2row(wl.py);
-
-			/*
-			 * If the user clicks below predefined timeouts
-			 * specific snapping behaviour is exposed.
-			 */
-			if (time - sel.tclick2 <= tripleclicktimeout) {
-				sel.snap = SNAP_LINE;
-			} else if (time - sel.tclick1 <= doubleclicktimeout) {
-				sel.snap = SNAP_WORD;
-			} else {
-				sel.snap = 0;
-			}
-			selnormalize();
-
-			if (sel.snap != 0)
-				sel.mode = SEL_READY;
-			tsetdirt(sel.nb.y, sel.ne.y);
-			sel.tclick2 = sel.tclick1;
-			sel.tclick1 = time;
-		}
-		break;
-	}
-}
-
-void
-ptraxis(void * data, struct wl_pointer * pointer, uint32_t time, uint32_t axis,
-        wl_fixed_t value)
-{
-	Axiskey *ak;
-	int dir = value > 0 ? +1 : -1;
-
-	if (IS_SET(MODE_MOUSE) && !(wl.xkb.mods & forceselmod)) {
-		wlmousereportaxis(axis, value);
-		return;
-	}
-
-	for (ak = ashortcuts; ak < ashortcuts + LEN(ashortcuts); ak++) {
-		if (axis == ak->axis && dir == ak->dir
-				&& match(ak->mask, wl.xkb.mods)) {
-			ttysend(ak->s, strlen(ak->s));
-			return;
-		}
-	}
-}
-
-void
-xdgshellping(void *data, struct xdg_shell *shell, uint32_t serial)
-{
-	xdg_shell_pong(shell, serial);
-}
-
-void
-xdgsurfconfigure(void *data, struct xdg_surface *surf, int32_t w, int32_t h,
-                 struct wl_array *states, uint32_t serial)
-{
-	xdg_surface_ack_configure(surf, serial);
-	if (w == wl.w && h == wl.h)
-		return;
-	cresize(w, h);
-	if (wl.configured)
-		ttyresize();
-	else
-		wl.configured = true;
-}
-
-void
-xdgsurfclose(void *data, struct xdg_surface *surf)
-{
-	/* Send SIGHUP to shell */
-	kill(pid, SIGHUP);
-	exit(0);
-}
-
-void
-datadevoffer(void *data, struct wl_data_device *datadev,
-             struct wl_data_offer *offer)
-{
-	wl_data_offer_add_listener(offer, &dataofferlistener, NULL);
-}
-
-void
-datadeventer(void *data, struct wl_data_device *datadev, uint32_t serial,
-		struct wl_surface *surf, wl_fixed_t x, wl_fixed_t y,
-		struct wl_data_offer *offer)
-{
-}
-
-void
-datadevleave(void *data, struct wl_data_device *datadev)
-{
-}
-
-void
-datadevmotion(void *data, struct wl_data_device *datadev, uint32_t time,
-              wl_fixed_t x, wl_fixed_t y)
-{
-}
-
-void
-datadevdrop(void *data, struct wl_data_device *datadev)
-{
-}
-
-void
-datadevselection(void *data, struct wl_data_device *datadev,
-                 struct wl_data_offer *offer)
-{
-	if (offer && (uintptr_t) wl_data_offer_get_user_data(offer) == 1)
-		wl.seloffer = offer;
-	else
-		wl.seloffer = NULL;
-}
-
-void
-dataofferoffer(void *data, struct wl_data_offer *offer, const char *mimetype)
-{
-	/* mark the offer as usable if it supports plain text */
-	if (strncmp(mimetype, "text/plain", 10) == 0)
-		wl_data_offer_set_user_data(offer, (void *)(uintptr_t) 1);
-}
-
-void
-datasrctarget(void *data, struct wl_data_source *source, const char *mimetype)
-{
-}
-
-void
-datasrcsend(void *data, struct wl_data_source *source, const char *mimetype,
-            int32_t fd)
-{
-	char *buf = sel.primary;
-	int len = strlen(sel.primary);
-	ssize_t ret;
-	while ((ret = write(fd, buf, MIN(len, BUFSIZ))) > 0) {
-		len -= ret;
-		buf += ret;
-	}
-	close(fd);
-}
-
-void
-datasrccancelled(void *data, struct wl_data_source *source)
-{
-	if (sel.source == source) {
-		sel.source = NULL;
-		selclear();
-	}
-	wl_data_source_destroy(source);
-}
-
-void
-run(void)
-{
-	fd_set rfd;
-	int wlfd = wl_display_get_fd(wl.dpy), blinkset = 0;
-	struct timespec drawtimeout, *tv = NULL, now, last, lastblink;
-	ulong msecs;
-
-	/* Look for initial configure. */
-	wl_display_roundtrip(wl.dpy);
-	if (!wl.configured)
-		cresize(wl.w, wl.h);
-	ttynew();
-	ttyresize();
-	draw();
-
-	clock_gettime(CLOCK_MONOTONIC, &last);
-	lastblink = last;
-
-	for (;;) {
-		FD_ZERO(&rfd);
-		FD_SET(cmdfd, &rfd);
-		FD_SET(wlfd, &rfd);
-
-		if (pselect(MAX(wlfd, cmdfd)+1, &rfd, NULL, NULL, tv, NULL) < 0) {
-			if (errno == EINTR)
-				continue;
-			die("select failed: %s\n", strerror(errno));
-		}
-
-		if (FD_ISSET(cmdfd, &rfd)) {
-			ttyread();
-			if (blinktimeout) {
-				blinkset = tattrset(ATTR_BLINK);
-				if (!blinkset)
-					MODBIT(term.mode, 0, MODE_BLINK);
-			}
-		}
-
-		if (FD_ISSET(wlfd, &rfd)) {
-			if (wl_display_dispatch(wl.dpy) == -1)
-				die("Connection error\n");
-		}
-
-		clock_gettime(CLOCK_MONOTONIC, &now);
-		msecs = -1;
-
-		if (blinkset && blinktimeout) {
-			if (TIMEDIFF(now, lastblink) >= blinktimeout) {
-				tsetdirtattr(ATTR_BLINK);
-				term.mode ^= MODE_BLINK;
-				lastblink = now;
-			} else {
-				msecs = MIN(msecs, blinktimeout - \
-						TIMEDIFF(now, lastblink));
-			}
-		}
-		if (repeat.len > 0) {
-			if (TIMEDIFF(now, repeat.last) >= \
-				(repeat.started ? keyrepeatinterval : \
-					keyrepeatdelay)) {
-				repeat.started = true;
-				repeat.last = now;
-				ttysend(repeat.str, repeat.len);
-			} else {
-				msecs = MIN(msecs, (repeat.started ? \
-					keyrepeatinterval : keyrepeatdelay) - \
-					TIMEDIFF(now, repeat.last));
-			}
-		}
-
-		if (needdraw && wl.state & WIN_VISIBLE) {
-			if (!wl.framecb) {
-				draw();
-			}
-		}
-
-		if (msecs == -1) {
-			tv = NULL;
-		} else {
-			drawtimeout.tv_nsec = 1E6 * msecs;
-			drawtimeout.tv_sec = 0;
-			tv = &drawtimeout;
-		}
-
-		wl_display_dispatch_pending(wl.dpy);
-		wl_display_flush(wl.dpy);
-	}
-}
-
-void
-usage(void)
-{
-	die("usage: %s [-aiv] [-c class] [-f font] [-g geometry]"
-	    " [-n name] [-o file]\n"
-	    "          [-T title] [-t title] [-w windowid]"
-	    " [[-e] command [args ...]]\n"
-	    "       %s [-aiv] [-c class] [-f font] [-g geometry]"
-	    " [-n name] [-o file]\n"
-	    "          [-T title] [-t title] [-w windowid] -l line"
-	    " [stty_args ...]\n", argv0, argv0);
-}
-
-int
-main(int argc, char *argv[])
-{
-	wl.cursor = cursorshape;
-
-	ARGBEGIN {
-	case 'a':
-		allowaltscreen = 0;
-		break;
-	case 'c':
-		opt_class = EARGF(usage());
-		break;
-	case 'e':
-		if (argc > 0)
-			--argc, ++argv;
-		goto run;
-	case 'f':
-		opt_font = EARGF(usage());
-		break;
-	case 'o':
-		opt_io = EARGF(usage());
-		break;
-	case 'l':
-		opt_line = EARGF(usage());
-		break;
-	case 'n':
-		opt_name = EARGF(usage());
-		break;
-	case 't':
-	case 'T':
-		opt_title = EARGF(usage());
-		break;
-	case 'w':
-		opt_embed = EARGF(usage());
-		break;
-	case 'v':
-		die("%s " VERSION " (c) 2010-2016 st engineers\n", argv0);
-		break;
-	default:
-		usage();
-	} ARGEND;
-
-run:
-	if (argc > 0) {
-		/* eat all remaining arguments */
-		opt_cmd = argv;
-		if (!opt_title && !opt_line)
-			opt_title = basename(xstrdup(argv[0]));
-	}
-	setlocale(LC_CTYPE, "");
-	tnew(MAX(cols, 1), MAX(rows, 1));
-	wlinit();
-	selinit();
-	run();
-
-	return 0;
-}
-
@@ -0,0 +1,280 @@
+/* See LICENSE for license details. */
+
+/* Arbitrary sizes */
+#define UTF_SIZ       4
+#define ESC_BUF_SIZ   (128*UTF_SIZ)
+#define GRID_ALIGN    64 /* cache line */
+#define STYLE_MAX     0xffff
+
+/* constants */
+#define RECMAGIC      "st-rec1\n"
+
+/* macros */
+#define MIN(a, b)		((a) < (b) ? (a) : (b))
+#define MAX(a, b)		((a) < (b) ? (b) : (a))
+#define LEN(a)			(sizeof(a) / sizeof(a)[0])
+#define DEFAULT(a, b)		(a) = (a) ? (a) : (b)
+#define BETWEEN(x, a, b)	((a) <= (x) && (x) <= (b))
+#define DIVCEIL(n, d)		(((n) + ((d) - 1)) / (d))
+#define LIMIT(x, a, b)		(x) = (x) < (a) ? (a) : (x) > (b) ? (b) : (x)
+#define ATTRCMP(a, b)		((a).mode != (b).mode || (a).style != (b).style)
+#define IS_SET(flag)		((term.mode & (flag)) != 0)
+#define TIMEDIFF(t1, t2)	((t1.tv_sec-t2.tv_sec)*1000 + \
+				(t1.tv_nsec-t2.tv_nsec)/1E6)
+#define MODBIT(x, set, bit)	((set) ? ((x) |= (bit)) : ((x) &= ~(bit)))
+#define TLINE(y)		((y) < term.scroll ? term.hist[(y)] : \
+				term.line[(y) - term.scroll])
+#define LINEINFO(line)		((LineInfo *)(line) - 1)
+
+#define TRUECOLOR(r,g,b)	(1 << 24 | (r) << 16 | (g) << 8 | (b))
+#define IS_TRUECOL(x)		(1 << 24 & (x))
+#define TRUERED(x)		(((x) & 0xff0000) >> 8)
+#define TRUEGREEN(x)		(((x) & 0xff00))
+#define TRUEBLUE(x)		(((x) & 0xff) << 8)
+
+enum glyph_attribute {
+	ATTR_NULL       = 0,
+	ATTR_BOLD       = 1 << 0,
+	ATTR_FAINT      = 1 << 1,
+	ATTR_ITALIC     = 1 << 2,
+	ATTR_UNDERLINE  = 1 << 3,
+	ATTR_BLINK      = 1 << 4,
+	ATTR_REVERSE    = 1 << 5,
+	ATTR_INVISIBLE  = 1 << 6,
+	ATTR_STRUCK     = 1 << 7,
+	ATTR_WRAP       = 1 << 8,
+	ATTR_WIDE       = 1 << 9,
+	ATTR_WDUMMY     = 1 << 10,
+	ATTR_BOLD_FAINT = ATTR_BOLD | ATTR_FAINT,
+};
+
+enum cursor_state {
+	CURSOR_DEFAULT  = 0,
+	CURSOR_WRAPNEXT = 1,
+	CURSOR_ORIGIN   = 2
+};
+
+enum term_mode {
+	MODE_WRAP        = 1 << 0,
+	MODE_INSERT      = 1 << 1,
+	MODE_APPKEYPAD   = 1 << 2,
+	MODE_ALTSCREEN   = 1 << 3,
+	MODE_CRLF        = 1 << 4,
+	MODE_MOUSEBTN    = 1 << 5,
+	MODE_MOUSEMOTION = 1 << 6,
+	MODE_REVERSE     = 1 << 7,
+	MODE_KBDLOCK     = 1 << 8,
+	MODE_HIDE        = 1 << 9,
+	MODE_ECHO        = 1 << 10,
+	MODE_APPCURSOR   = 1 << 11,
+	MODE_MOUSESGR    = 1 << 12,
+	MODE_8BIT        = 1 << 13,
+	MODE_BLINK       = 1 << 14,
+	MODE_FBLINK      = 1 << 15,
+	MODE_FOCUS       = 1 << 16,
+	MODE_MOUSEX10    = 1 << 17,
+	MODE_MOUSEMANY   = 1 << 18,
+	MODE_BRCKTPASTE  = 1 << 19,
+	MODE_PRINT       = 1 << 20,
+	MODE_UTF8        = 1 << 21,
+	MODE_SIXEL       = 1 << 22,
+	MODE_MOUSE       = MODE_MOUSEBTN|MODE_MOUSEMOTION|MODE_MOUSEX10\
+	                  |MODE_MOUSEMANY,
+};
+
+enum record_type {
+	REC_DATA   = 'd',
+	REC_RESIZE = 'r'
+};
+
+enum selection_mode {
+	SEL_IDLE = 0,
+	SEL_EMPTY = 1,
+	SEL_READY = 2
+};
+
+enum selection_type {
+	SEL_REGULAR = 1,
+	SEL_RECTANGULAR = 2
+};
+
+enum selection_snap {
+	SNAP_WORD = 1,
+	SNAP_LINE = 2
+};
+
+typedef unsigned char uchar;
+typedef unsigned int uint;
+typedef unsigned long ulong;
+typedef unsigned short ushort;
+
+typedef uint_least32_t Rune;
+
+typedef struct {
+	uint32_t fg;      /* foreground  */
+	uint32_t bg;      /* background  */
+} Style;
+
+typedef struct {
+	Rune u;           /* character code */
+	ushort mode;      /* attribute flags */
+	ushort style;     /* index of its colors in styles */
+} Glyph;
+
+typedef Glyph *Line;
+
+/* kept up to date by the writes to a screen line, just before its cells */
+typedef struct {
+	ushort blink; /* nb of blinking cells */
+	ushort len;   /* cells up to the last one that is not a space */
+} LineInfo;
+
+typedef struct {
+	int x0;       /* first dirty column */
+	int x1;       /* last one, less than x0 if the line is clean */
+} Dirty;
+
+typedef struct {
+	Glyph attr; /* current char attributes */
+	uint32_t fg; /* the colors of attr.style */
+	uint32_t bg;
+	int x;
+	int y;
+	char state;
+} TCursor;
+
+/* Internal representation of the screen */
+typedef struct {
+	int row;      /* nb row */
+	int col;      /* nb col */
+	Line *line;   /* screen */
+	Line *alt;    /* alternate screen */
+	Line *ring;   /* 2*row pointers line is a window into */
+	Line *altring;
+	Glyph *grid;  /* the glyphs of all lines, in one slab */
+	Glyph *altgrid;
+	int scroll;   /* nb of history lines shown above the screen */
+	Line *hist;   /* those lines, decoded */
+	Glyph *histgrid;
+	Dirty *dirty; /* dirtyness of the rows shown */
+	TCursor c;    /* cursor */
+	int top;      /* top    scroll limit */
+	int bot;      /* bottom scroll limit */
+	int mode;     /* terminal mode flags */
+	int esc;      /* escape state flags */
+	char trantbl[4]; /* charset table translation */
+	int charset;  /* current charset */
+	int icharset; /* selected charset for sequence */
+	int numlock; /* lock numbers in keyboard */
+	int *tabs;
+} Term;
+
+typedef struct {
+	int mode;
+	int type;
+	int snap;
+	/*
+	 * Selection variables:
+	 * nb – normalized coordinates of the beginning of the selection
+	 * ne – normalized coordinates of the end of the selection
+	 * ob – original coordinates of the beginning of the selection
+	 * oe – original coordinates of the end of the selection
+	 */
+	struct {
+		int x, y;
+	} nb, ne, ob, oe;
+
+	int alt;
+} Selection;
+
+/* one record of a session recording */
+typedef struct {
+	int type;
+	ulong delay;  /* microseconds since the previous record */
+	char *data;   /* REC_DATA: what was read from the tty */
+	size_t len;
+	size_t siz;
+	int col, row; /* REC_RESIZE */
+} Record;
+
+typedef union {
+	int i;
+	uint ui;
+	float f;
+	const void *v;
+} Arg;
+
+void die(const char *, ...);
+
+void printscreen(const Arg *);
+void printsel(const Arg *);
+void iso14755(const Arg *);
+void kscrolldown(const Arg *);
+void kscrollup(const Arg *);
+void sendbreak(const Arg *);
+void toggleprinter(const Arg *);
+
+void tfulldirt(void);
+int tlinelen(Line);
+void tnew(int, int);
+void tresize(int, int);
+void tsetdirt(int, int);
+void tsetdirtblink(void);
+void tsetview(int);
+int tblinking(void);
+int twrite(char *, int);
+ushort tstyle(uint32_t, uint32_t);
+
+void ttynew(char *, char *, char **);
+size_t ttyread(void);
+void ttyhangup(void);
+void ttyrecord(char *);
+void ttyreplay(char *, int);
+void ttyresize(int, int);
+void ttysend(char *, size_t);
+void ttywrite(const char *, size_t);
+
+FILE *recopen(char *);
+int recnext(FILE *, Record *);
+
+void selclear(void);
+void selinit(void);
+void selnormalize(void);
+int selected(int, int);
+char *getsel(void);
+void selsnap(int *, int *, int);
+
+size_t utf8decode(char *, Rune *, size_t);
+size_t utf8encode(Rune, char *);
+int runewidth(Rune);
+
+void *xmalloc(size_t);
+void *xrealloc(void *, size_t);
+void *xmemalign(size_t, size_t);
+char *xstrdup(char *);
+
+/* Globals */
+extern Term term;
+extern Selection sel;
+extern Style styles[STYLE_MAX];
+extern int cmdfd;
+extern bool needdraw;
+extern size_t xallocs;
+
+/* config.h globals */
+extern char *shell;
+extern char *utmp;
+extern char *stty_args;
+extern char *vtiden;
+extern char *worddelimiters;
+extern char *termname;
+extern int allowaltscreen;
+extern unsigned int tabspaces;
+extern unsigned int defaultfg;
+extern unsigned int defaultbg;
+extern unsigned int ttybufsize;
+extern unsigned int ttydrainmax;
+extern unsigned int ttydraintimeout;
+extern unsigned int strbufmax;
+extern unsigned int histsize;
+extern int histspill;
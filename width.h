@@ -0,0 +1,1171 @@
+/* generated by mkwidth.sh from Unicode 14.0.0, do not edit */
+
+#define WIDTH_UNICODE "14.0.0"
+
+/* block of every 256 code points */
+static const unsigned char widthidx[4352] = {
+	0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 1, 1, 19, 20, 21, 22, 23, 24, 25, 26, 1, 27,
+	28, 29, 1, 30, 31, 32, 33, 34, 1, 1, 1, 35, 36, 37, 38, 39,
+	40, 41, 42, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 44, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 45, 1, 46, 47, 48, 49, 50, 51, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 52, 53, 53, 53, 53, 53, 53, 53, 53,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 43, 54, 55, 1, 56, 57, 58,
+	59, 60, 61, 62, 63, 64, 1, 65, 66, 67, 68, 69, 70, 71, 72, 73,
+	74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 53, 85, 86, 87, 88,
+	1, 1, 1, 89, 90, 91, 53, 53, 53, 53, 53, 53, 53, 53, 53, 92,
+	1, 1, 1, 1, 93, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 1, 1, 94, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 1, 1, 95, 96, 53, 53, 97, 98,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 99, 43, 43, 43, 43, 100, 101, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 102,
+	43, 103, 104, 53, 53, 53, 53, 53, 53, 53, 53, 53, 105, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 106,
+	107, 108, 109, 110, 111, 112, 113, 114, 1, 1, 115, 53, 53, 53, 53, 116,
+	117, 118, 119, 53, 53, 53, 53, 120, 121, 122, 53, 53, 123, 124, 125, 53,
+	126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 53, 53, 53, 53,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 138, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 139, 140, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 141, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 142, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 43, 43, 143, 53, 53, 53, 53, 53,
+	43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+	43, 43, 43, 144, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	145, 146, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 147,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 147,
+};
+
+/* 2 bits per code point, lowest first: 0, 1, 2 or 3 for -1 */
+static const unsigned char widthblk[148][64] = {
+	{
+		252, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 85, 85, 95, 85,
+		255, 85, 213, 93, 85, 85, 85, 85, 117, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		21, 0, 80, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 87, 85, 85, 85,
+		85, 85, 85, 85, 85, 213, 87, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 213, 87, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16,
+		65, 16, 255, 255, 85, 85, 85, 85, 85, 85, 213, 127, 85, 253, 255, 255,
+	},
+	{
+		0, 80, 85, 85, 0, 0, 64, 84, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 21, 0, 0, 0, 0, 0, 85, 85, 85, 85, 84, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 5, 0, 16, 0, 20, 4, 80, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 53, 81, 85, 85, 85, 85, 85, 85, 85, 0, 0, 0, 0,
+		0, 0, 192, 87, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 5, 0, 0, 244, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 0, 0, 85, 213, 83,
+	},
+	{
+		85, 85, 85, 85, 85, 5, 16, 0, 0, 1, 1, 240, 85, 85, 85, 213,
+		85, 85, 85, 85, 85, 85, 1, 223, 85, 85, 213, 255, 85, 85, 85, 85,
+		85, 85, 85, 213, 240, 255, 0, 0, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		64, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 69, 84,
+		1, 0, 84, 81, 1, 0, 85, 85, 5, 85, 85, 85, 85, 85, 85, 85,
+		81, 87, 85, 125, 125, 85, 85, 85, 85, 85, 93, 85, 221, 95, 245, 84,
+		1, 124, 125, 209, 255, 127, 255, 117, 5, 95, 85, 85, 85, 85, 85, 197,
+	},
+	{
+		67, 87, 213, 127, 125, 85, 85, 85, 85, 85, 93, 85, 93, 215, 245, 92,
+		193, 63, 60, 240, 243, 255, 87, 221, 255, 95, 85, 85, 80, 209, 255, 255,
+		67, 87, 85, 117, 117, 85, 85, 85, 85, 85, 93, 85, 93, 87, 245, 84,
+		1, 48, 116, 241, 253, 255, 255, 255, 5, 95, 85, 85, 245, 255, 7, 0,
+	},
+	{
+		83, 87, 85, 125, 125, 85, 85, 85, 85, 85, 93, 85, 93, 87, 245, 20,
+		1, 124, 125, 241, 255, 67, 255, 117, 5, 95, 85, 85, 85, 85, 255, 255,
+		79, 87, 213, 95, 93, 245, 215, 93, 127, 253, 213, 95, 85, 85, 245, 95,
+		212, 95, 93, 241, 253, 127, 255, 255, 255, 95, 85, 85, 85, 85, 213, 255,
+	},
+	{
+		84, 84, 85, 93, 93, 85, 85, 85, 85, 85, 93, 85, 85, 85, 245, 4,
+		84, 13, 12, 240, 255, 195, 213, 247, 5, 95, 85, 85, 255, 127, 85, 85,
+		81, 85, 85, 93, 93, 85, 85, 85, 85, 85, 93, 85, 85, 87, 245, 20,
+		85, 77, 93, 240, 255, 215, 255, 215, 5, 95, 85, 85, 215, 255, 255, 255,
+	},
+	{
+		80, 85, 85, 93, 93, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 84,
+		1, 92, 93, 81, 255, 85, 85, 85, 5, 95, 85, 85, 85, 85, 85, 85,
+		83, 87, 85, 85, 85, 213, 95, 85, 85, 85, 85, 85, 117, 85, 85, 247,
+		85, 213, 207, 127, 5, 204, 85, 85, 255, 95, 85, 85, 95, 253, 255, 255,
+	},
+	{
+		87, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 81, 0, 192, 127,
+		85, 21, 0, 64, 85, 85, 85, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		215, 93, 213, 85, 85, 85, 85, 85, 85, 119, 85, 85, 81, 0, 0, 244,
+		85, 221, 0, 240, 85, 85, 245, 85, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 80, 85, 85, 85, 85, 85, 85, 17, 81, 85,
+		85, 85, 87, 85, 85, 85, 85, 85, 85, 85, 85, 253, 3, 0, 0, 64,
+		0, 4, 85, 1, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 92,
+		85, 69, 85, 93, 85, 85, 213, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 1, 4, 0, 65, 65,
+		85, 85, 85, 85, 85, 85, 80, 5, 84, 85, 85, 85, 1, 84, 85, 85,
+		69, 65, 85, 81, 85, 85, 85, 81, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 117, 255, 247, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 93, 245, 85, 213, 93, 245, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 93, 245, 85, 85, 85, 85, 85, 85, 85, 85, 93, 245, 85, 213,
+		93, 245, 85, 85, 85, 213, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 93, 245, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 213, 3, 85, 85, 85, 85, 85, 85, 85, 253,
+		85, 85, 85, 85, 85, 85, 245, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 85, 245,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 253, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 253, 255,
+	},
+	{
+		85, 85, 85, 85, 5, 244, 255, 127, 85, 85, 85, 85, 5, 213, 255, 255,
+		85, 85, 85, 85, 5, 255, 255, 255, 85, 85, 85, 93, 13, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 16, 0, 80,
+		85, 69, 1, 0, 0, 85, 85, 241, 85, 85, 245, 255, 85, 85, 245, 255,
+	},
+	{
+		85, 85, 21, 0, 85, 85, 245, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 253, 255,
+		85, 65, 85, 85, 85, 85, 85, 85, 85, 85, 209, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 213, 64, 21, 84, 255, 69, 85, 1, 255,
+		253, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 85, 253, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 85, 85, 85, 85,
+		85, 85, 245, 255, 85, 85, 213, 95, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 21, 20, 95, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 69, 0, 192, 68, 1, 0, 84, 21, 0, 0, 60,
+		85, 85, 245, 255, 85, 85, 245, 255, 85, 85, 85, 245, 0, 0, 0, 0,
+		0, 0, 0, 192, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		0, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 4, 64, 84,
+		69, 85, 85, 253, 85, 85, 85, 85, 85, 85, 21, 0, 0, 85, 85, 213,
+		80, 85, 85, 85, 85, 85, 85, 85, 5, 80, 16, 80, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 69, 80, 17, 80, 255, 255, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 0, 5, 127, 85,
+		85, 85, 245, 87, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 253, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 87,
+		85, 85, 255, 255, 64, 0, 0, 0, 4, 0, 84, 81, 85, 84, 208, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		85, 85, 85, 85, 85, 245, 85, 245, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 245, 85, 245, 85, 85, 119, 119, 85, 85, 85, 85, 85, 85, 85, 245,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 93, 85, 85,
+		85, 93, 85, 85, 85, 95, 85, 87, 85, 85, 85, 85, 95, 93, 85, 213,
+	},
+	{
+		85, 85, 21, 0, 85, 85, 85, 85, 85, 85, 5, 64, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 0, 12, 0, 0, 245, 85, 85, 85,
+		85, 85, 85, 213, 85, 85, 85, 253, 85, 85, 85, 85, 85, 85, 85, 85,
+		253, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 252, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 165, 85, 85, 85, 105, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 169, 86, 150, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 255, 255, 255, 255, 255,
+		85, 85, 213, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 105,
+	},
+	{
+		85, 85, 85, 85, 85, 90, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 170, 170, 170, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 149,
+		85, 85, 85, 85, 149, 85, 85, 85, 89, 85, 165, 85, 85, 85, 85, 105,
+		85, 90, 85, 101, 85, 86, 85, 85, 85, 85, 101, 85, 165, 89, 101, 89,
+	},
+	{
+		85, 89, 165, 85, 85, 85, 85, 85, 85, 85, 86, 85, 85, 85, 85, 85,
+		85, 85, 85, 102, 149, 154, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 169, 85, 85, 85, 85, 85, 85, 86, 85, 85, 149,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 149, 86, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 86, 89, 85, 85, 85, 85, 85, 85, 85, 95, 85, 85,
+		85, 85, 85, 85, 85, 117, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 80, 255, 87, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 117, 255, 247, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 127, 253, 255, 255, 63,
+		85, 85, 85, 85, 85, 213, 255, 255, 85, 213, 85, 213, 85, 213, 85, 213,
+		85, 213, 85, 213, 85, 213, 85, 213, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255,
+		170, 170, 170, 170, 170, 170, 186, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 250, 255, 255, 255, 255, 255, 255, 170, 170, 170, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 10, 160, 170, 170, 170, 106,
+		171, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 234, 131, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		255, 171, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 171, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 234, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 255, 255, 255, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 234, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 85, 85, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 254, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 234, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 64, 0, 0, 80,
+		85, 85, 85, 85, 85, 85, 85, 5, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 80, 85, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 213, 255, 117, 87, 245, 255, 255, 255, 255, 255, 95, 85, 85, 85,
+	},
+	{
+		69, 69, 21, 85, 85, 85, 85, 85, 85, 65, 85, 252, 85, 85, 245, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 240, 255, 95, 85, 85, 245, 255, 0, 0, 0, 0, 80, 85, 85, 21,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 5, 0, 80, 85, 85, 85, 85,
+		85, 21, 0, 0, 80, 255, 255, 127, 170, 170, 170, 170, 170, 170, 170, 254,
+		64, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 5, 80, 80,
+		85, 85, 85, 117, 85, 85, 245, 95, 85, 81, 85, 85, 85, 85, 85, 213,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 1, 64, 65, 193, 255, 255,
+		21, 85, 85, 244, 85, 85, 245, 85, 85, 85, 85, 85, 85, 85, 85, 84,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 4, 20, 84, 5,
+		209, 255, 255, 255, 255, 255, 127, 85, 85, 85, 85, 80, 85, 197, 255, 255,
+	},
+	{
+		87, 213, 87, 213, 87, 213, 255, 255, 85, 213, 85, 213, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 81, 84, 241, 85, 85, 245, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 255, 255, 255, 0, 0, 0, 0,
+		0, 192, 63, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 250, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 250, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 213, 255, 255, 127, 85, 255, 71, 85, 85, 85, 85, 85, 213, 85, 221,
+		117, 93, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		213, 255, 255, 255, 127, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 95, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 255, 127, 255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85,
+	},
+	{
+		0, 0, 0, 0, 170, 170, 250, 255, 0, 0, 0, 0, 170, 170, 170, 170,
+		170, 170, 170, 170, 234, 170, 170, 170, 170, 234, 170, 255, 85, 93, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 61,
+	},
+	{
+		171, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 86, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213,
+		95, 85, 95, 85, 95, 85, 95, 253, 170, 234, 85, 213, 255, 255, 3, 245,
+	},
+	{
+		85, 85, 85, 87, 85, 85, 85, 85, 85, 213, 85, 85, 85, 85, 213, 117,
+		85, 85, 85, 245, 85, 85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255,
+	},
+	{
+		213, 127, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 127, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 213, 85, 85, 85, 253, 253, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 241,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 253, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 253, 255, 255, 255, 84, 85, 85, 85, 85, 85, 85, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 87, 85, 85, 85, 85,
+		85, 85, 213, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 5, 192, 255,
+		85, 85, 85, 85, 85, 85, 85, 117, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 255, 85, 85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 245, 85, 85, 245, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 127, 85, 85, 213, 85,
+		85, 85, 213, 85, 213, 117, 85, 85, 117, 85, 85, 85, 117, 85, 117, 253,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 255,
+		85, 85, 85, 85, 85, 245, 255, 255, 85, 85, 255, 255, 255, 255, 255, 255,
+		85, 117, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 93, 85, 213, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 245, 93, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 117, 253, 125,
+		85, 85, 85, 85, 85, 117, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 213, 255, 127, 85, 85, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 213, 245, 127, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 127, 85, 85, 85, 85, 85, 85, 245, 127,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 85,
+		85, 85, 85, 85, 95, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		1, 195, 255, 0, 85, 87, 87, 85, 85, 85, 85, 85, 85, 245, 192, 63,
+		85, 85, 253, 255, 85, 85, 253, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 193, 127, 85, 85, 213, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 87, 85,
+		85, 85, 85, 85, 85, 245, 85, 85, 85, 85, 85, 85, 213, 255, 85, 85,
+		85, 85, 85, 85, 245, 255, 87, 253, 255, 255, 87, 85, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 253, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 95, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 255, 255, 85, 85, 245, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 213,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 53, 244, 245, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 85, 85, 85, 85,
+		85, 5, 0, 0, 84, 85, 245, 255, 255, 255, 255, 255, 85, 85, 85, 85,
+		5, 80, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85,
+		85, 85, 85, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 213, 255, 255,
+	},
+	{
+		81, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 0,
+		0, 64, 85, 245, 95, 85, 85, 85, 85, 85, 85, 85, 20, 244, 255, 63,
+		80, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 64, 65, 81,
+		197, 255, 255, 243, 85, 85, 85, 85, 85, 85, 253, 255, 85, 85, 245, 255,
+	},
+	{
+		64, 85, 85, 85, 85, 85, 85, 85, 85, 21, 0, 1, 0, 92, 85, 85,
+		85, 85, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85, 21, 213, 255, 255,
+		80, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 5, 0, 64,
+		85, 85, 1, 20, 85, 85, 85, 85, 87, 85, 85, 85, 85, 253, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 117, 85, 85, 85, 85, 85, 85, 21, 80, 4, 85, 197,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 213, 93, 117, 85, 85, 85, 117, 85, 85, 245, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 21, 21, 0, 192, 255, 85, 85, 245, 255,
+	},
+	{
+		80, 87, 85, 125, 125, 85, 85, 85, 85, 85, 93, 85, 93, 87, 53, 84,
+		84, 125, 125, 245, 253, 127, 255, 87, 85, 15, 0, 252, 0, 252, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 0,
+		5, 68, 85, 85, 85, 85, 85, 71, 245, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 0, 68, 21,
+		4, 85, 255, 255, 85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 5, 240, 85, 16,
+		84, 85, 85, 85, 85, 85, 85, 240, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 0, 64, 17,
+		84, 253, 255, 255, 85, 85, 245, 255, 85, 85, 85, 253, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 81, 0, 16, 245, 255,
+		85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 213, 3, 5, 16, 0, 255, 85, 85, 85, 85,
+		85, 213, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 0, 0, 65, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 255, 127,
+	},
+	{
+		85, 213, 247, 85, 85, 215, 85, 85, 85, 85, 85, 85, 85, 117, 61, 68,
+		21, 213, 255, 255, 85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 95, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 0, 15, 85, 84, 253, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		1, 0, 64, 85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 0, 20, 64,
+		85, 21, 255, 255, 1, 64, 1, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 5, 0, 0, 64, 80, 85, 213, 255, 255, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 253, 255,
+	},
+	{
+		85, 85, 93, 85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 192, 0, 16,
+		85, 245, 255, 255, 85, 85, 85, 85, 85, 85, 85, 253, 85, 85, 85, 85,
+		85, 85, 85, 85, 15, 0, 0, 0, 0, 0, 7, 0, 4, 193, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 213, 117, 85, 85, 85, 85, 85, 85, 85, 85, 85, 1, 192, 207, 48,
+		0, 16, 255, 255, 85, 85, 245, 255, 85, 117, 93, 85, 85, 85, 85, 85,
+		85, 85, 85, 213, 112, 17, 253, 255, 85, 85, 245, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 21, 84, 253, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 253, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 255, 255, 127,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 85, 253, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 0, 0, 252, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 213, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 253, 255,
+		85, 85, 85, 85, 85, 85, 85, 213, 85, 85, 245, 95, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213,
+		85, 85, 245, 255, 85, 85, 85, 85, 85, 85, 85, 245, 0, 244, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 64, 85, 85,
+		85, 245, 255, 255, 85, 85, 117, 85, 117, 85, 85, 85, 85, 85, 255, 87,
+		85, 85, 85, 85, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 213, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 213, 63, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 255, 63, 64, 85, 85, 85, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 170, 252, 255, 255, 250, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 250, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		170, 170, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 170, 171, 170, 235,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 234, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 234, 255, 255, 255, 255, 170, 255, 255, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 85, 85, 85, 253,
+		85, 85, 253, 255, 85, 85, 245, 65, 0, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 240, 0, 0, 0, 0,
+		0, 192, 255, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 87, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 21, 80, 85, 21, 0, 0, 0,
+		64, 1, 0, 85, 85, 85, 85, 85, 85, 85, 5, 80, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 213, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		5, 244, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 85, 85, 85, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 213, 255, 255, 85, 85, 85, 85, 85, 85, 253, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 93, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 93, 223, 215, 87, 93, 85, 85, 117, 87,
+		85, 87, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 117, 213, 87, 85, 93, 85, 93, 85, 85, 85, 85, 85, 85, 117, 213,
+		85, 221, 95, 85, 93, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 245, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 95, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64, 21, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 84, 85, 81, 85, 85,
+		85, 84, 85, 255, 255, 255, 63, 0, 3, 0, 0, 0, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 213, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		0, 192, 0, 0, 0, 0, 60, 0, 48, 12, 192, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 253, 0, 64, 85, 245,
+		85, 85, 245, 95, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 85, 85, 85, 85, 85, 85, 85, 197, 255, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 0, 85, 85, 245, 127,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 85, 213, 85, 215, 85, 85, 85, 213,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 125, 85, 85, 0, 192, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 0, 64, 255, 85, 85, 245, 95, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 87, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 253, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		87, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 87, 85, 85, 85, 85, 85, 85, 215, 125, 87, 85, 213, 85, 119, 255,
+		223, 127, 119, 87, 215, 125, 119, 119, 215, 125, 213, 85, 213, 85, 87, 221,
+		85, 85, 117, 85, 85, 85, 85, 255, 87, 87, 117, 85, 85, 85, 85, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 245, 255, 255, 255,
+	},
+	{
+		85, 86, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 255, 255, 255, 85, 85, 85, 213, 87, 85, 85, 85,
+		87, 85, 85, 149, 87, 85, 85, 85, 85, 85, 85, 85, 85, 245, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 101, 169, 170, 106, 85, 85, 85, 85, 245, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 95, 85, 85, 85, 85, 85, 85,
+	},
+	{
+		234, 255, 255, 255, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 255,
+		170, 170, 254, 255, 250, 255, 255, 255, 170, 250, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 86, 85, 85, 169, 170, 154, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 166,
+		170, 170, 170, 170, 170, 85, 85, 85, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 106, 149, 170, 85, 85, 85, 170, 170, 170, 170, 86, 86, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 106,
+		166, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 150,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 90,
+		85, 85, 149, 106, 170, 170, 170, 170, 170, 170, 85, 85, 85, 85, 101, 85,
+		85, 85, 85, 85, 85, 105, 85, 85, 85, 86, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 149, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 90, 85, 86, 106, 169, 255, 171, 85, 85, 149, 254, 85, 170, 170, 254,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 255, 255, 255,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 253, 255, 170, 170, 170, 255, 254, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 255, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 255, 255, 85, 85, 245, 255, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 255, 255, 85, 85, 85, 85, 85, 85, 85, 245, 245, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 106, 170,
+		170, 154, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 255, 255, 255, 85, 85, 85, 245, 170, 254, 170, 254,
+		170, 234, 255, 255, 170, 170, 170, 170, 170, 170, 170, 254, 170, 170, 234, 255,
+		170, 250, 255, 255, 170, 170, 250, 255, 170, 170, 255, 255, 170, 234, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 213, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 213, 255, 255, 255, 255, 255, 255, 255, 255, 255, 85, 85, 245, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 254, 255,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 250, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 250, 255, 255, 255, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 170, 170, 170, 170, 170, 170, 254, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 250, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+		170, 170, 234, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		243, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255,
+	},
+	{
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85,
+		85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 85, 245,
+	},
+};
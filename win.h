@@ -0,0 +1,11 @@
+/* See LICENSE for license details. */
+
+/* front end functions called by the terminal */
+void redraw(void);
+void wlbell(void);
+void wlloadcols(void);
+void wlresettitle(void);
+int wlsetcolorname(int, const char *);
+void wlsetcursor(int);
+void wlsetsel(char *);
+void wlsettitle(char *);
@@ -0,0 +1,2854 @@
+/* See LICENSE for license details. */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+/* for BTN_* definitions */
+#include <linux/input.h>
+#include <locale.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <pthread.h>
+#include <wayland-client.h>
+#include <wayland-cursor.h>
+#include <xkbcommon/xkbcommon.h>
+#include <wld/wld.h>
+#include <wld/wayland.h>
+#include <fontconfig/fontconfig.h>
+
+#include "arg.h"
+#include "st.h"
+#include "win.h"
+#include "xdg-shell-unstable-v5-client-protocol.h"
+
+char *argv0;
+
+/* Arbitrary sizes */
+#define DRAW_BUF_SIZ  20*1024
+#define ATLAS_COLS    64
+#define ATLAS_ROWS    32
+#define FCREQ_MAX     64
+#define BUF_MAX       3
+
+/* constants */
+#define FCCMAGIC      "st-fcc1"
+#define XK_ANY_MOD    UINT_MAX
+#define XK_NO_MOD     0
+#define XK_SWITCH_MOD (1<<13)
+
+#define MOD_MASK_ANY	UINT_MAX
+#define MOD_MASK_NONE	0
+#define MOD_MASK_CTRL	(1<<0)
+#define MOD_MASK_ALT	(1<<1)
+#define MOD_MASK_SHIFT	(1<<2)
+#define MOD_MASK_LOGO	(1<<3)
+
+#define AXIS_VERTICAL	WL_POINTER_AXIS_VERTICAL_SCROLL
+#define AXIS_HORIZONTAL	WL_POINTER_AXIS_HORIZONTAL_SCROLL
+
+enum window_state {
+	WIN_VISIBLE = 1,
+	WIN_FOCUSED = 2
+};
+
+typedef struct {
+	struct xkb_context *ctx;
+	struct xkb_keymap *keymap;
+	struct xkb_state *state;
+	xkb_mod_index_t ctrl, alt, shift, logo;
+	unsigned int mods;
+} XKB;
+
+typedef struct {
+	struct wl_display *dpy;
+	struct wl_compositor *cmp;
+	struct wl_shm *shm;
+	struct wl_seat *seat;
+	struct wl_keyboard *keyboard;
+	struct wl_pointer *pointer;
+	struct wl_data_device_manager *datadevmanager;
+	struct wl_data_device *datadev;
+	struct wl_data_offer *seloffer;
+	struct wl_surface *surface;
+	struct xdg_shell *shell;
+	struct xdg_surface *xdgsurface;
+	XKB xkb;
+	bool configured;
+	int px, py; /* pointer x and y */
+	int tw, th; /* tty width and height */
+	int w, h; /* window width and height */
+	int ch; /* char height */
+	int cw; /* char width  */
+	int vis;
+	char state; /* focus, redraw, visible */
+	int cursor; /* cursor style */
+	uint32_t serial; /* of the last input event */
+	struct wl_callback * framecb;
+	bool damagebuffer; /* wl_surface has damage_buffer */
+} Wayland;
+
+/* one of the buffers frames are drawn into */
+typedef struct {
+	struct wld_buffer *wld;
+	struct wl_buffer *wl;
+	bool busy;    /* attached and not released yet */
+	bool gone;    /* dropped by a resize while busy */
+	uint frame;   /* the last one drawn into it, 0 if none */
+	Dirty *dirty; /* cells changed since, by row */
+} Buffer;
+
+typedef struct {
+	struct wld_context *ctx;
+	struct wld_font_context *fontctx;
+	struct wld_renderer *renderer;
+	struct wld_buffer *buffer; /* the target of the frame being drawn */
+	Buffer *pool[BUF_MAX];
+	Buffer *cur;
+	uint frame;   /* nb of frames drawn */
+} WLD;
+
+/* pixels repainted, x1 and y1 excluded */
+typedef struct {
+	int x0, y0;
+	int x1, y1;
+} Rect;
+
+typedef struct {
+	struct wl_cursor_theme *theme;
+	struct wl_cursor *cursor;
+	struct wl_surface *surface;
+} Cursor;
+
+typedef struct {
+	uint b;
+	uint mask;
+	char *s;
+} MouseShortcut;
+
+typedef struct {
+	int axis;
+	int dir;
+	uint mask;
+	void (*func)(const Arg *);
+	const Arg arg;
+	char s[ESC_BUF_SIZ];
+} Axiskey;
+
+typedef struct {
+	xkb_keysym_t k;
+	uint mask;
+	char *s;
+	/* three valued logic variables: 0 indifferent, 1 on, -1 off */
+	signed char appkey;    /* application keypad */
+	signed char appcursor; /* application cursor */
+	signed char crlf;      /* crlf mode          */
+} Key;
+
+/* selection as seen by the compositor */
+typedef struct {
+	char *primary;
+	struct wl_data_source *source;
+	uint32_t tclick1, tclick2;
+} WlSelection;
+
+typedef struct {
+	uint mod;
+	xkb_keysym_t keysym;
+	void (*func)(const Arg *);
+	const Arg arg;
+} Shortcut;
+
+typedef struct {
+	char str[32];
+	uint32_t key;
+	int len;
+	bool started;
+	struct timespec last;
+} Repeat;
+
+/* function definitions used in config.h */
+static void numlock(const Arg *);
+static void selpaste(const Arg *);
+static void wlzoom(const Arg *);
+static void wlzoomabs(const Arg *);
+static void wlzoomreset(const Arg *);
+
+/* Config.h for applying patches and the configuration. */
+#include "coreconfig.h"
+#include "config.h"
+
+/* Font structure */
+typedef struct {
+	int height;
+	int width;
+	int ascent;
+	int descent;
+	int badslant;
+	int badweight;
+	short lbearing;
+	short rbearing;
+	struct wld_font *match;
+	FcPattern *pattern;
+} Font;
+
+/* Drawing Context */
+typedef struct {
+	uint32_t col[MAX(LEN(colorname), 256)];
+	Font font, bfont, ifont, ibfont;
+} DC;
+
+static void draw(void);
+static void drawregion(int, int, int, int);
+static void run(void);
+static void cresize(int, int);
+
+static inline int match(uint, uint);
+
+static inline uchar sixd_to_8bit(int);
+static int wlatlasdraw(Font *, int, Rune, uint32_t, uint32_t, int, int, int);
+static int frcfont(Font *, int, Rune);
+static int frclookup(Rune, int);
+static int frcopen(int, FcPattern *);
+static void frcresolved(void);
+static void *fcworker(void *);
+static uint64_t fcchash(uint64_t, const void *, size_t);
+static void fccload(void);
+static void fccmap(void);
+static char *fcclookup(Rune, int, int *);
+static void fccsave(void);
+static void frcinsert(Rune, int, int);
+static void frclink(int);
+static void frcunlink(int);
+static void frcreset(void);
+static void wldamage(int, int, int);
+static void wldraws(char *, Glyph, int, int, int, int);
+static void wldrawglyph(Glyph, int, int);
+static void wlclear(int, int, int, int);
+static void wldrawcursor(void);
+static void wlinit(void);
+static void wlloadcursor(void);
+static int wlloadfont(Font *, FcPattern *);
+static void wlloadfonts(char *, double);
+static void wlseturgency(int);
+static void wlunloadfont(Font *f);
+static void wlunloadfonts(void);
+static void wlresize(int, int);
+static Buffer *bufget(void);
+static void buffree(Buffer *);
+
+static void regglobal(void *, struct wl_registry *, uint32_t, const char *,
+		uint32_t);
+static void regglobalremove(void *, struct wl_registry *, uint32_t);
+static void surfenter(void *, struct wl_surface *, struct wl_output *);
+static void surfleave(void *, struct wl_surface *, struct wl_output *);
+static void framedone(void *, struct wl_callback *, uint32_t);
+static void bufrelease(void *, struct wl_buffer *);
+static void kbdkeymap(void *, struct wl_keyboard *, uint32_t, int32_t, uint32_t);
+static void kbdenter(void *, struct wl_keyboard *, uint32_t,
+		struct wl_surface *, struct wl_array *);
+static void kbdleave(void *, struct wl_keyboard *, uint32_t,
+		struct wl_surface *);
+static void kbdkey(void *, struct wl_keyboard *, uint32_t, uint32_t, uint32_t,
+		uint32_t);
+static void kbdmodifiers(void *, struct wl_keyboard *, uint32_t, uint32_t,
+		uint32_t, uint32_t, uint32_t);
+static void kbdrepeatinfo(void *, struct wl_keyboard *, int32_t, int32_t);
+static void ptrenter(void *, struct wl_pointer *, uint32_t, struct wl_surface *,
+		wl_fixed_t, wl_fixed_t);
+static void ptrleave(void *, struct wl_pointer *, uint32_t,
+		struct wl_surface *);
+static void ptrmotion(void *, struct wl_pointer *, uint32_t,
+		wl_fixed_t, wl_fixed_t);
+static void ptrbutton(void *, struct wl_pointer *, uint32_t, uint32_t,
+		uint32_t, uint32_t);
+static void ptraxis(void *, struct wl_pointer *, uint32_t, uint32_t,
+		wl_fixed_t);
+static void xdgshellping(void *, struct xdg_shell *, uint32_t);
+static void xdgsurfconfigure(void *, struct xdg_surface *,
+		int32_t, int32_t, struct wl_array *, uint32_t);
+static void xdgsurfclose(void *, struct xdg_surface *);
+static void datadevoffer(void *, struct wl_data_device *,
+		struct wl_data_offer *);
+static void datadeventer(void *, struct wl_data_device *, uint32_t,
+		struct wl_surface *, wl_fixed_t, wl_fixed_t, struct wl_data_offer *);
+static void datadevleave(void *, struct wl_data_device *);
+static void datadevmotion(void *, struct wl_data_device *, uint32_t,
+		wl_fixed_t x, wl_fixed_t y);
+static void datadevdrop(void *, struct wl_data_device *);
+static void datadevselection(void *, struct wl_data_device *,
+		struct wl_data_offer *);
+static void dataofferoffer(void *, struct wl_data_offer *, const char *);
+static void datasrctarget(void *, struct wl_data_source *, const char *);
+static void datasrcsend(void *, struct wl_data_source *, const char *, int32_t);
+static void datasrccancelled(void *, struct wl_data_source *);
+
+static void selcopy(void);
+static int x2col(int);
+static int y2row(int);
+
+static void usage(void);
+
+static struct wl_registry_listener reglistener = { regglobal, regglobalremove };
+static struct wl_surface_listener surflistener = { surfenter, surfleave };
+static struct wl_callback_listener framelistener = { framedone };
+static struct wl_buffer_listener buflistener = { bufrelease };
+static struct wl_keyboard_listener kbdlistener =
+	{ kbdkeymap, kbdenter, kbdleave, kbdkey, kbdmodifiers, kbdrepeatinfo };
+static struct wl_pointer_listener ptrlistener =
+	{ ptrenter, ptrleave, ptrmotion, ptrbutton, ptraxis };
+static struct xdg_shell_listener xdgshelllistener = { xdgshellping };
+static struct xdg_surface_listener xdgsurflistener =
+	{ xdgsurfconfigure, xdgsurfclose };
+static struct wl_data_device_listener datadevlistener =
+	{ datadevoffer, datadeventer, datadevleave, datadevmotion, datadevdrop,
+	  datadevselection };
+static struct wl_data_offer_listener dataofferlistener = { dataofferoffer };
+static struct wl_data_source_listener datasrclistener =
+	{ datasrctarget, datasrcsend, datasrccancelled };
+
+/* Globals */
+static DC dc;
+static Wayland wl;
+static WLD wld;
+static Cursor cursor;
+static WlSelection wlsel;
+static Repeat repeat;
+static char **opt_cmd  = NULL;
+static char *opt_class = NULL;
+static char *opt_embed = NULL;
+static char *opt_font  = NULL;
+static char *opt_io    = NULL;
+static char *opt_line  = NULL;
+static char *opt_name  = NULL;
+static char *opt_play  = NULL;
+static char *opt_rec   = NULL;
+static char *opt_title = NULL;
+static int opt_realtime = 0;
+static int oldbutton   = 3; /* button event on startup: 3 = release */
+static int oldx, oldy;
+static Rect *damage;   /* of the frame being drawn */
+static int ndamage, damagesiz;
+
+static char *usedfont = NULL;
+static double usedfontsize = 0;
+static double defaultfontsize = 0;
+
+/* Font Ring Cache */
+enum {
+	FRC_NORMAL,
+	FRC_ITALIC,
+	FRC_BOLD,
+	FRC_ITALICBOLD
+};
+
+/* fallback fonts, shared by the runes of the same flags they cover */
+typedef struct {
+	struct wld_font *font;
+	int flags;
+	char *file;  /* along with index, tells the fonts apart */
+	int index;
+	int refs;    /* nb of runes mapped to it, the slot is free at 0 */
+} Fontcache;
+
+/* the runes missing from the main fonts, hashed and in order of use */
+typedef struct {
+	Rune u;
+	int flags;
+	int font;    /* in frc, -1 if no font has it */
+	int next;    /* in the same bucket */
+	int older;
+	int newer;
+} Runecache;
+
+#define RCHASH(u, flags)	(((u) * 2654435761U ^ (flags)) % fallbackrunes)
+
+/* one font more than runes, so that there is always a free slot */
+static Fontcache *frc;
+static Runecache *rc;
+static int *rcbucket;
+static int rclen, rcoldest, rcnewest;
+
+/* a fallback font lookup, left to the fontconfig worker thread */
+typedef struct {
+	Rune u;
+	int flags;
+	int gen;            /* of the main fonts it is for */
+	FcPattern *pattern; /* of the main font, then the match */
+} Fcrequest;
+
+static Fcrequest *fcreq[FCREQ_MAX];
+static int fcnreq, fcgen;
+static int fcto[2] = { -1, -1 }, fcfrom[2] = { -1, -1 }; /* pipes */
+
+/*
+ * The fallback fonts found by earlier sts with the same main font, kept
+ * in $XDG_CACHE_HOME/st. The file is a header, the ranges sorted by
+ * flags then rune, and the names of the font files they point into.
+ */
+typedef struct {
+	char magic[8];  /* FCCMAGIC */
+	uint64_t stamp; /* of the fontconfig setup it was made with */
+	uint32_t nrange;
+	uint32_t nstr;  /* bytes of file names */
+} Fccheader;
+
+typedef struct {
+	uint32_t first; /* runes */
+	uint32_t last;
+	uint32_t flags;
+	uint32_t index; /* of the face in the file */
+	uint32_t file;  /* offset of its name */
+} Fccrange;
+
+typedef struct {
+	char path[PATH_MAX];
+	uint64_t stamp;
+	char *map;
+	size_t maplen;
+	Fccrange *range;
+	uint32_t nrange;
+	char *str;
+	uint32_t nstr;
+	struct {
+		Rune u;
+		int flags;
+		int index;
+		char *file;
+	} *new;        /* found since, to be saved */
+	int nnew;
+} Fcc;
+
+static Fcc fcc;
+
+/* Glyph atlas: cells rendered once in the main fonts, then copied */
+typedef struct {
+	Rune u;
+	int flags;    /* FRC_* and the width in cells, -1 if the slot is free */
+	uint32_t fg;
+	uint32_t bg;
+} AtlasKey;
+
+typedef struct {
+	struct wld_buffer *buffer;
+	AtlasKey key[ATLAS_COLS * ATLAS_ROWS];
+} Atlas;
+
+static Atlas atlas;
+
+int
+x2col(int x)
+{
+	x -= borderpx;
+	x /= wl.cw;
+
+	return LIMIT(x, 0, term.col-1);
+}
+
+int
+y2row(int y)
+{
+	y -= borderpx;
+	y /= wl.ch;
+
+	return LIMIT(y, 0, term.row-1);
+}
+
+void
+getbuttoninfo(void)
+{
+	int type;
+	uint state = wl.xkb.mods & ~forceselmod;
+
+	sel.alt = IS_SET(MODE_ALTSCREEN);
+
+	sel.oe.x = x2col(wl.px);
+	sel.oe.y = y2row(wl.py);
+	selnormalize();
+
+	sel.type = SEL_REGULAR;
+	for (type = 1; type < LEN(selmasks); ++type) {
+		if (match(selmasks[type], state)) {
+			sel.type = type;
+			break;
+		}
+	}
+}
+
+void
+wlmousereport(int button, bool release, int x, int y)
+{
+	int len;
+	char buf[40];
+
+	if (!IS_SET(MODE_MOUSEX10)) {
+		button += ((wl.xkb.mods & MOD_MASK_SHIFT) ? 4  : 0)
+			+ ((wl.xkb.mods & MOD_MASK_LOGO ) ? 8  : 0)
+			+ ((wl.xkb.mods & MOD_MASK_CTRL ) ? 16 : 0);
+	}
+
+	if (IS_SET(MODE_MOUSESGR)) {
+		len = snprintf(buf, sizeof(buf), "\033[<%d;%d;%d%c",
+				button, x+1, y+1, release ? 'm' : 'M');
+	} else if (x < 223 && y < 223) {
+		len = snprintf(buf, sizeof(buf), "\033[M%c%c%c",
+				32+button, 32+x+1, 32+y+1);
+	} else {
+		return;
+	}
+
+	ttywrite(buf, len);
+}
+
+void
+wlmousereportbutton(uint32_t button, uint32_t state)
+{
+	bool release = state == WL_POINTER_BUTTON_STATE_RELEASED;
+
+	if (!IS_SET(MODE_MOUSESGR) && release) {
+		button = 3;
+	} else {
+		switch (button) {
+		case BTN_LEFT:
+			button = 0;
+			break;
+		case BTN_MIDDLE:
+			button = 1;
+			break;
+		case BTN_RIGHT:
+			button = 2;
+			break;
+		}
+	}
+
+	oldbutton = release ? 3 : button;
+
+	/* don't report release events when in X10 mode */
+	if (IS_SET(MODE_MOUSEX10) && release) {
+		return;
+	}
+
+	wlmousereport(button, release, oldx, oldy);
+}
+
+void
+wlmousereportmotion(wl_fixed_t fx, wl_fixed_t fy)
+{
+	int x = x2col(wl_fixed_to_int(fx)), y = y2row(wl_fixed_to_int(fy));
+
+	if (x == oldx && y == oldy)
+		return;
+	if (!IS_SET(MODE_MOUSEMOTION) && !IS_SET(MODE_MOUSEMANY))
+		return;
+	/* MOUSE_MOTION: no reporting if no button is pressed */
+	if (IS_SET(MODE_MOUSEMOTION) && oldbutton == 3)
+		return;
+
+	oldx = x;
+	oldy = y;
+	wlmousereport(oldbutton + 32, false, x, y);
+}
+
+void
+wlmousereportaxis(uint32_t axis, wl_fixed_t amount)
+{
+	wlmousereport(64 + (axis == AXIS_VERTICAL ? 4 : 6)
+		+ (amount > 0 ? 1 : 0), false, oldx, oldy);
+}
+
+void
+selcopy(void)
+{
+	wlsetsel(getsel());
+}
+
+static inline void
+selwritebuf(char *buf, int len)
+{
+	char *repl = buf;
+
+	/*
+	 * As seen in getsel:
+	 * Line endings are inconsistent in the terminal and GUI world
+	 * copy and pasting. When receiving some selection data,
+	 * replace all '\n' with '\r'.
+	 * FIXME: Fix the computer world.
+	 */
+	while ((repl = memchr(repl, '\n', len))) {
+		*repl++ = '\r';
+	}
+
+	ttysend(buf, len);
+}
+
+void
+selpaste(const Arg *dummy)
+{
+	int fds[2], len, left;
+	char buf[BUFSIZ], *str;
+
+	if (wl.seloffer) {
+		if (IS_SET(MODE_BRCKTPASTE))
+			ttywrite("\033[200~", 6);
+		/* check if we are pasting from ourselves */
+		if (wlsel.source) {
+			str = wlsel.primary;
+			left = strlen(wlsel.primary);
+			while (left > 0) {
+				len = MIN(sizeof buf, left);
+				memcpy(buf, str, len);
+				selwritebuf(buf, len);
+				left -= len;
+				str += len;
+			}
+		} else {
+			pipe(fds);
+			wl_data_offer_receive(wl.seloffer, "text/plain", fds[1]);
+			wl_display_flush(wl.dpy);
+			close(fds[1]);
+			while ((len = read(fds[0], buf, sizeof buf)) > 0) {
+				selwritebuf(buf, len);
+			}
+			close(fds[0]);
+		}
+		if (IS_SET(MODE_BRCKTPASTE))
+			ttywrite("\033[201~", 6);
+	}
+}
+
+void
+wlsetsel(char *str)
+{
+	free(wlsel.primary);
+	wlsel.primary = str;
+
+	if (str) {
+		wlsel.source = wl_data_device_manager_create_data_source(wl.datadevmanager);
+		wl_data_source_add_listener(wlsel.source, &datasrclistener, NULL);
+		wl_data_source_offer(wlsel.source, "text/plain; charset=utf-8");
+	} else {
+		wlsel.source = NULL;
+	}
+	wl_data_device_set_selection(wl.datadev, wlsel.source, wl.serial);
+}
+
+void
+wlresize(int col, int row)
+{
+	int i;
+
+	wl.tw = MAX(1, col * wl.cw);
+	wl.th = MAX(1, row * wl.ch);
+
+	/* new buffers are made as needed, the shown ones go on release */
+	for (i = 0; i < BUF_MAX && wld.pool[i]; i++) {
+		if (wld.pool[i]->busy)
+			wld.pool[i]->gone = true;
+		else
+			buffree(wld.pool[i]);
+		wld.pool[i] = NULL;
+	}
+}
+
+/*
+ * The free buffer drawn into last, which has the least to repaint, or a
+ * new one while there are less than BUF_MAX. NULL if all are held by the
+ * compositor.
+ */
+Buffer *
+bufget(void)
+{
+	union wld_object object;
+	Buffer *b = NULL;
+	int i, y;
+
+	for (i = 0; i < BUF_MAX && wld.pool[i]; i++) {
+		if (!wld.pool[i]->busy && (!b || wld.pool[i]->frame > b->frame))
+			b = wld.pool[i];
+	}
+	if (b || i == BUF_MAX)
+		return b;
+
+	b = xmalloc(sizeof(*b));
+	if (!(b->wld = wld_create_buffer(wld.ctx, wl.w, wl.h,
+			WLD_FORMAT_XRGB8888, 0)))
+		die("Can't create buffer\n");
+	wld_export(b->wld, WLD_WAYLAND_OBJECT_BUFFER, &object);
+	b->wl = object.ptr;
+	wl_buffer_add_listener(b->wl, &buflistener, b);
+	b->busy = b->gone = false;
+	b->frame = 0;
+	/* nothing is drawn in it yet */
+	b->dirty = xmalloc(term.row * sizeof(*b->dirty));
+	for (y = 0; y < term.row; y++)
+		b->dirty[y] = (Dirty){ 0, term.col-1 };
+
+	return wld.pool[i] = b;
+}
+
+void
+buffree(Buffer *b)
+{
+	wld_buffer_unreference(b->wld);
+	free(b->dirty);
+	free(b);
+}
+
+uchar
+sixd_to_8bit(int x)
+{
+	return x == 0 ? 0 : 0x37 + 0x28 * x;
+}
+
+int
+wlloadcolor(int i, const char *name, uint32_t *color)
+{
+	if (!name) {
+		if (BETWEEN(i, 16, 255)) { /* 256 color */
+			if (i < 6*6*6+16) { /* same colors as xterm */
+				*color = 0xff << 24 | sixd_to_8bit(((i-16)/36)%6) << 16
+					| sixd_to_8bit(((i-16)/6)%6) << 8
+					| sixd_to_8bit(((i-16)/1)%6);
+			} else { /* greyscale */
+				*color = 0xff << 24 | (0x8 + 0xa * (i-(6*6*6+16))) * 0x10101;
+			}
+			return true;
+		} else
+			name = colorname[i];
+	}
+
+	return wld_lookup_named_color(name, color);
+}
+
+void
+wlloadcols(void)
+{
+	int i;
+
+	for (i = 0; i < LEN(dc.col); i++)
+		if (!wlloadcolor(i, NULL, &dc.col[i])) {
+			if (colorname[i])
+				die("Could not allocate color '%s'\n", colorname[i]);
+			else
+				die("Could not allocate color %d\n", i);
+		}
+}
+
+int
+wlsetcolorname(int x, const char *name)
+{
+	uint32_t color;
+
+	if (!BETWEEN(x, 0, LEN(dc.col)))
+		return 1;
+
+	if (!wlloadcolor(x, name, &color))
+		return 1;
+
+	dc.col[x] = color;
+
+	return 0;
+}
+
+static void wlloadcursor(void)
+{
+	char *names[] = { mouseshape, "xterm", "ibeam", "text" };
+	int i;
+
+	cursor.theme = wl_cursor_theme_load(NULL, 32, wl.shm);
+
+	for (i = 0; !cursor.cursor && i < LEN(names); i++)
+		cursor.cursor = wl_cursor_theme_get_cursor(cursor.theme, names[i]);
+
+	cursor.surface = wl_compositor_create_surface(wl.cmp);
+}
+
+/*
+ * Absolute coordinates.
+ */
+void
+wlclear(int x1, int y1, int x2, int y2)
+{
+	uint32_t color = dc.col[IS_SET(MODE_REVERSE) ? defaultfg : defaultbg];
+
+	wld_fill_rectangle(wld.renderer, color, x1, y1, x2 - x1, y2 - y1);
+}
+
+int
+wlloadfont(Font *f, FcPattern *pattern)
+{
+	FcPattern *configured;
+	FcPattern *match;
+	FcResult result;
+	struct wld_extents extents;
+	int wantattr, haveattr;
+
+	/*
+	 * Manually configure instead of calling XftMatchFont
+	 * so that we can use the configured pattern for
+	 * "missing glyph" lookups.
+	 */
+	configured = FcPatternDuplicate(pattern);
+	if (!configured)
+		return 1;
+
+	FcConfigSubstitute(NULL, configured, FcMatchPattern);
+	FcDefaultSubstitute(configured);
+
+	match = FcFontMatch(NULL, configured, &result);
+	if (!match) {
+		FcPatternDestroy(configured);
+		return 1;
+	}
+
+	if (!(f->match = wld_font_open_pattern(wld.fontctx, match))) {
+		FcPatternDestroy(configured);
+		FcPatternDestroy(match);
+		return 1;
+	}
+
+	if ((FcPatternGetInteger(pattern, "slant", 0, &wantattr) ==
+	    FcResultMatch)) {
+		/*
+		 * Check if xft was unable to find a font with the appropriate
+		 * slant but gave us one anyway. Try to mitigate.
+		 */
+		if ((FcPatternGetInteger(match, "slant", 0,
+		    &haveattr) != FcResultMatch) || haveattr < wantattr) {
+			f->badslant = 1;
+			fputs("st: font slant does not match\n", stderr);
+		}
+	}
+
+	if ((FcPatternGetInteger(pattern, "weight", 0, &wantattr) ==
+	    FcResultMatch)) {
+		if ((FcPatternGetInteger(match, "weight", 0,
+		    &haveattr) != FcResultMatch) || haveattr != wantattr) {
+			f->badweight = 1;
+			fputs("st: font weight does not match\n", stderr);
+		}
+	}
+
+
+	wld_font_text_extents(f->match, ascii_printable, &extents);
+
+	f->pattern = configured;
+
+	f->ascent = f->match->ascent;
+	f->descent = f->match->descent;
+	f->lbearing = 0;
+	f->rbearing = f->match->max_advance;
+
+	f->height = f->ascent + f->descent;
+	f->width = DIVCEIL(extents.advance, strlen(ascii_printable));
+
+	return 0;
+}
+
+void
+wlloadfonts(char *fontstr, double fontsize)
+{
+	FcPattern *pattern;
+	double fontval;
+	float ceilf(float);
+
+	if (fontstr[0] == '-') {
+		/* XXX: need XftXlfdParse equivalent */
+		pattern = NULL;
+	} else {
+		pattern = FcNameParse((FcChar8 *)fontstr);
+	}
+
+	if (!pattern)
+		die("st: can't open font %s\n", fontstr);
+
+	if (fontsize > 1) {
+		FcPatternDel(pattern, FC_PIXEL_SIZE);
+		FcPatternDel(pattern, FC_SIZE);
+		FcPatternAddDouble(pattern, FC_PIXEL_SIZE, (double)fontsize);
+		usedfontsize = fontsize;
+	} else {
+		if (FcPatternGetDouble(pattern, FC_PIXEL_SIZE, 0, &fontval) ==
+				FcResultMatch) {
+			usedfontsize = fontval;
+		} else if (FcPatternGetDouble(pattern, FC_SIZE, 0, &fontval) ==
+				FcResultMatch) {
+			usedfontsize = -1;
+		} else {
+			/*
+			 * Default font size is 12, if none given. This is to
+			 * have a known usedfontsize value.
+			 */
+			FcPatternAddDouble(pattern, FC_PIXEL_SIZE, 12);
+			usedfontsize = 12;
+		}
+		defaultfontsize = usedfontsize;
+	}
+
+	FcConfigSubstitute(0, pattern, FcMatchPattern);
+	FcDefaultSubstitute(pattern);
+
+	if (wlloadfont(&dc.font, pattern))
+		die("st: can't open font %s\n", fontstr);
+
+	if (usedfontsize < 0) {
+		FcPatternGetDouble(dc.font.pattern,
+		                   FC_PIXEL_SIZE, 0, &fontval);
+		usedfontsize = fontval;
+		if (fontsize == 0)
+			defaultfontsize = fontval;
+	}
+
+	/* Setting character width and height. */
+	wl.cw = ceilf(dc.font.width * cwscale);
+	wl.ch = ceilf(dc.font.height * chscale);
+
+	/*
+	 * A slot is room for a wide char, below and after a cell of margin
+	 * where glyphs can overhang without spilling onto their neighbours.
+	 */
+	atlas.buffer = wld_create_buffer(wld.ctx, ATLAS_COLS * 3 * wl.cw,
+			ATLAS_ROWS * 2 * wl.ch, WLD_FORMAT_XRGB8888, 0);
+	memset(atlas.key, 0xff, sizeof(atlas.key));
+
+	FcPatternDel(pattern, FC_SLANT);
+	FcPatternAddInteger(pattern, FC_SLANT, FC_SLANT_ITALIC);
+	if (wlloadfont(&dc.ifont, pattern))
+		die("st: can't open font %s\n", fontstr);
+
+	FcPatternDel(pattern, FC_WEIGHT);
+	FcPatternAddInteger(pattern, FC_WEIGHT, FC_WEIGHT_BOLD);
+	if (wlloadfont(&dc.ibfont, pattern))
+		die("st: can't open font %s\n", fontstr);
+
+	FcPatternDel(pattern, FC_SLANT);
+	FcPatternAddInteger(pattern, FC_SLANT, FC_SLANT_ROMAN);
+	if (wlloadfont(&dc.bfont, pattern))
+		die("st: can't open font %s\n", fontstr);
+
+	FcPatternDestroy(pattern);
+	fccload();
+}
+
+void
+wlunloadfont(Font *f)
+{
+	wld_font_close(f->match);
+	FcPatternDestroy(f->pattern);
+}
+
+void
+wlunloadfonts(void)
+{
+	/* Free the loaded fonts in the font cache.  */
+	frcreset();
+
+	wlunloadfont(&dc.font);
+	wlunloadfont(&dc.bfont);
+	wlunloadfont(&dc.ifont);
+	wlunloadfont(&dc.ibfont);
+
+	if (atlas.buffer)
+		wld_buffer_unreference(atlas.buffer);
+	atlas.buffer = NULL;
+}
+
+void
+wlzoom(const Arg *arg)
+{
+	Arg larg;
+
+	larg.f = usedfontsize + arg->f;
+	wlzoomabs(&larg);
+}
+
+void
+wlzoomabs(const Arg *arg)
+{
+	wlunloadfonts();
+	wlloadfonts(usedfont, arg->f);
+	cresize(0, 0);
+	ttyresize(wl.tw, wl.th);
+	redraw();
+	/* XXX: Should the window size be updated here because wayland doesn't
+	 * have a notion of hints?
+	 * xhints();
+	 */
+}
+
+void
+wlzoomreset(const Arg *arg)
+{
+	Arg larg;
+
+	if (defaultfontsize > 0) {
+		larg.f = defaultfontsize;
+		wlzoomabs(&larg);
+	}
+}
+
+void
+wlinit(void)
+{
+	struct wl_registry *registry;
+
+	if (!(wl.dpy = wl_display_connect(NULL)))
+		die("Can't open display\n");
+
+	registry = wl_display_get_registry(wl.dpy);
+	wl_registry_add_listener(registry, &reglistener, NULL);
+	wld.ctx = wld_wayland_create_context(wl.dpy, WLD_ANY);
+	wld.renderer = wld_create_renderer(wld.ctx);
+
+	wl_display_roundtrip(wl.dpy);
+
+	if (!wl.shm)
+		die("Display has no SHM\n");
+	if (!wl.seat)
+		die("Display has no seat\n");
+	if (!wl.datadevmanager)
+		die("Display has no data device manager\n");
+
+	wl.keyboard = wl_seat_get_keyboard(wl.seat);
+	wl_keyboard_add_listener(wl.keyboard, &kbdlistener, NULL);
+	wl.pointer = wl_seat_get_pointer(wl.seat);
+	wl_pointer_add_listener(wl.pointer, &ptrlistener, NULL);
+	wl.datadev = wl_data_device_manager_get_data_device(wl.datadevmanager,
+			wl.seat);
+	wl_data_device_add_listener(wl.datadev, &datadevlistener, NULL);
+
+	/* font */
+	if (!FcInit())
+		die("Could not init fontconfig.\n");
+
+	usedfont = (opt_font == NULL)? font : opt_font;
+	wld.fontctx = wld_font_create_context();
+	frcreset();
+	wlloadfonts(usedfont, 0);
+
+	wlloadcols();
+	wlloadcursor();
+
+	wl.vis = 0;
+	wl.h = 2 * borderpx + term.row * wl.ch;
+	wl.w = 2 * borderpx + term.col * wl.cw;
+
+	wl.surface = wl_compositor_create_surface(wl.cmp);
+	wl_surface_add_listener(wl.surface, &surflistener, NULL);
+
+	wl.xdgsurface = xdg_shell_get_xdg_surface(wl.shell, wl.surface);
+	xdg_surface_add_listener(wl.xdgsurface, &xdgsurflistener, NULL);
+	xdg_surface_set_app_id(wl.xdgsurface, opt_class ? opt_class : termname);
+
+	wl.xkb.ctx = xkb_context_new(0);
+	wlresettitle();
+}
+
+/* Close all fallback fonts and forget the runes mapped to them. */
+void
+frcreset(void)
+{
+	int i;
+
+	if (!frc) {
+		frc = xmalloc((fallbackrunes + 1) * sizeof(*frc));
+		rc = xmalloc(fallbackrunes * sizeof(*rc));
+		rcbucket = xmalloc(fallbackrunes * sizeof(*rcbucket));
+	} else {
+		for (i = 0; i <= fallbackrunes; i++) {
+			if (frc[i].refs) {
+				wld_font_close(frc[i].font);
+				free(frc[i].file);
+			}
+		}
+	}
+	memset(frc, 0, (fallbackrunes + 1) * sizeof(*frc));
+	for (i = 0; i < fallbackrunes; i++)
+		rcbucket[i] = -1;
+	rclen = 0;
+	rcoldest = rcnewest = -1;
+
+	/* the other lookups still running will be for nothing */
+	fcgen++;
+}
+
+void
+frcunlink(int i)
+{
+	if (rc[i].older >= 0)
+		rc[rc[i].older].newer = rc[i].newer;
+	else
+		rcoldest = rc[i].newer;
+	if (rc[i].newer >= 0)
+		rc[rc[i].newer].older = rc[i].older;
+	else
+		rcnewest = rc[i].older;
+}
+
+void
+frclink(int i)
+{
+	rc[i].older = rcnewest;
+	rc[i].newer = -1;
+	if (rcnewest >= 0)
+		rc[rcnewest].newer = i;
+	else
+		rcoldest = i;
+	rcnewest = i;
+}
+
+/* The entry of u in the rune cache, used last now, or -1. */
+int
+frclookup(Rune u, int flags)
+{
+	int i;
+
+	for (i = rcbucket[RCHASH(u, flags)]; i >= 0; i = rc[i].next) {
+		if (rc[i].u == u && rc[i].flags == flags) {
+			frcunlink(i);
+			frclink(i);
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/* Map u to font, in place of the least recently drawn rune if need be. */
+void
+frcinsert(Rune u, int flags, int font)
+{
+	int i, f, *p;
+
+	/* the font may be the one whose last rune goes */
+	if (font >= 0)
+		frc[font].refs++;
+
+	if (rclen < fallbackrunes) {
+		i = rclen++;
+	} else {
+		i = rcoldest;
+		frcunlink(i);
+		for (p = &rcbucket[RCHASH(rc[i].u, rc[i].flags)]; *p != i;
+				p = &rc[*p].next)
+			/* nothing */ ;
+		*p = rc[i].next;
+		f = rc[i].font;
+		if (f >= 0 && --frc[f].refs == 0) {
+			wld_font_close(frc[f].font);
+			free(frc[f].file);
+		}
+	}
+
+	rc[i].u = u;
+	rc[i].flags = flags;
+	rc[i].font = font;
+	p = &rcbucket[RCHASH(u, flags)];
+	rc[i].next = *p;
+	*p = i;
+	frclink(i);
+}
+
+/*
+ * The fallback font to draw u in, missing from font, or -1 while the
+ * worker looks for it and if no font has it.
+ */
+int
+frcfont(Font *font, int flags, Rune u)
+{
+	pthread_t worker;
+	FcPattern *pattern;
+	Fcrequest *r;
+	char *file;
+	int i, index;
+
+	if ((i = frclookup(u, flags)) >= 0)
+		return rc[i].font;
+
+	/* Search the fonts open already. */
+	for (i = 0; i <= fallbackrunes; i++) {
+		if (frc[i].refs && frc[i].flags == flags
+				&& wld_font_ensure_char(frc[i].font, u)) {
+			frcinsert(u, flags, i);
+			return i;
+		}
+	}
+
+	/* an earlier st may have looked for it already */
+	if ((file = fcclookup(u, flags, &index))) {
+		pattern = FcPatternDuplicate(font->pattern);
+		FcPatternDel(pattern, FC_FILE);
+		FcPatternDel(pattern, FC_INDEX);
+		FcPatternAddString(pattern, FC_FILE, (FcChar8 *)file);
+		FcPatternAddInteger(pattern, FC_INDEX, index);
+		i = frcopen(flags, pattern);
+		FcPatternDestroy(pattern);
+		frcinsert(u, flags, i);
+		return i;
+	}
+
+	for (i = 0; i < fcnreq; i++) {
+		if (fcreq[i]->u == u && fcreq[i]->flags == flags
+				&& fcreq[i]->gen == fcgen)
+			return -1;
+	}
+	if (fcnreq == FCREQ_MAX)
+		return -1;
+
+	/* the worker starts after the shell was forked */
+	if (fcto[0] < 0) {
+		if (pipe(fcto) < 0 || pipe(fcfrom) < 0)
+			die("pipe failed: %s\n", strerror(errno));
+		for (i = 0; i < 2; i++) {
+			fcntl(fcto[i], F_SETFD, FD_CLOEXEC);
+			fcntl(fcfrom[i], F_SETFD, FD_CLOEXEC);
+		}
+		if ((errno = pthread_create(&worker, NULL, fcworker, NULL)))
+			die("pthread_create failed: %s\n", strerror(errno));
+	}
+
+	r = xmalloc(sizeof(*r));
+	*r = (Fcrequest){ u, flags, fcgen, FcPatternDuplicate(font->pattern) };
+	fcreq[fcnreq++] = r;
+	/* no more than FCREQ_MAX pointers are ever in the pipe */
+	if (write(fcto[1], &r, sizeof(r)) != sizeof(r))
+		die("write to the fontconfig worker failed: %s\n",
+				strerror(errno));
+
+	return -1;
+}
+
+/* The slot of the fallback font match is, opening it if need be. */
+int
+frcopen(int flags, FcPattern *match)
+{
+	FcChar8 *file;
+	int i, index;
+
+	if (FcPatternGetString(match, FC_FILE, 0, &file) != FcResultMatch)
+		file = (FcChar8 *)"";
+	if (FcPatternGetInteger(match, FC_INDEX, 0, &index) != FcResultMatch)
+		index = 0;
+
+	/* It may be one open for other runes, lacking this one too. */
+	for (i = 0; i <= fallbackrunes; i++) {
+		if (frc[i].refs && frc[i].flags == flags
+				&& frc[i].index == index
+				&& !strcmp(frc[i].file, (char *)file))
+			return i;
+	}
+
+	for (i = 0; frc[i].refs; i++)
+		/* nothing */ ;
+	frc[i].font = wld_font_open_pattern(wld.fontctx, match);
+	frc[i].flags = flags;
+	frc[i].file = xstrdup((char *)file);
+	frc[i].index = index;
+
+	return i;
+}
+
+/* Take the answer of the worker, redrawing the rows that wait for it. */
+void
+frcresolved(void)
+{
+	Fcrequest *r;
+	int i, x, y;
+
+	if (read(fcfrom[0], &r, sizeof(r)) != sizeof(r))
+		die("read from the fontconfig worker failed: %s\n",
+				strerror(errno));
+
+	if (!r->pattern && r->gen == fcgen) {
+		/* drawn in the main font, not to be asked again */
+		frcinsert(r->u, r->flags, -1);
+	} else if (r->gen == fcgen) {
+		i = frcopen(r->flags, r->pattern);
+		frcinsert(r->u, r->flags, i);
+		if (fcc.path[0]) {
+			fcc.new = xrealloc(fcc.new,
+					(fcc.nnew + 1) * sizeof(*fcc.new));
+			fcc.new[fcc.nnew].u = r->u;
+			fcc.new[fcc.nnew].flags = r->flags;
+			fcc.new[fcc.nnew].index = frc[i].index;
+			fcc.new[fcc.nnew++].file = xstrdup(frc[i].file);
+		}
+	}
+
+	for (y = 0; y < term.row; y++) {
+		for (x = 0; x < term.col; x++) {
+			if (TLINE(y)[x].u == r->u) {
+				tsetdirt(y, y);
+				break;
+			}
+		}
+	}
+
+	for (i = 0; fcreq[i] != r; i++)
+		/* nothing */ ;
+	fcreq[i] = fcreq[--fcnreq];
+	if (r->pattern)
+		FcPatternDestroy(r->pattern);
+	free(r);
+
+	/* save once the worker is done with what the screen asked for */
+	if (fcnreq == 0 && fcc.nnew)
+		fccsave();
+}
+
+/*
+ * The worker thread: match the fallback fonts of the requests it is
+ * sent, and send them back.
+ */
+void *
+fcworker(void *arg)
+{
+	/* the fonts sorted for each of the main fonts, as of gen */
+	FcFontSet *sets[FRC_ITALICBOLD + 1] = { NULL };
+	int gens[FRC_ITALICBOLD + 1] = { 0 };
+	FcPattern *fcpattern;
+	FcCharSet *fccharset;
+	FcResult fcres;
+	Fcrequest *r;
+
+	while (read(fcto[0], &r, sizeof(r)) == sizeof(r)) {
+		if (!sets[r->flags] || gens[r->flags] != r->gen) {
+			if (sets[r->flags])
+				FcFontSetDestroy(sets[r->flags]);
+			sets[r->flags] = FcFontSort(0, r->pattern, 1, 0, &fcres);
+			gens[r->flags] = r->gen;
+		}
+
+		/*
+		 * Now use some dozen of Fontconfig calls to get the
+		 * font for one single character.
+		 *
+		 * Xft and fontconfig are design failures.
+		 */
+		fcpattern = FcPatternDuplicate(r->pattern);
+		fccharset = FcCharSetCreate();
+
+		FcCharSetAddChar(fccharset, r->u);
+		FcPatternAddCharSet(fcpattern, FC_CHARSET, fccharset);
+		FcPatternAddBool(fcpattern, FC_SCALABLE, 1);
+
+		FcConfigSubstitute(0, fcpattern, FcMatchPattern);
+		FcDefaultSubstitute(fcpattern);
+
+		FcPatternDestroy(r->pattern);
+		r->pattern = sets[r->flags] ? FcFontSetMatch(0,
+				&sets[r->flags], 1, fcpattern, &fcres) : NULL;
+
+		FcPatternDestroy(fcpattern);
+		FcCharSetDestroy(fccharset);
+
+		if (write(fcfrom[1], &r, sizeof(r)) != sizeof(r))
+			break;
+	}
+
+	return NULL;
+}
+
+/* FNV-1a */
+uint64_t
+fcchash(uint64_t h, const void *p, size_t len)
+{
+	const uchar *s = p;
+
+	while (len--)
+		h = (h ^ *s++) * 0x100000001b3ULL;
+
+	return h;
+}
+
+/*
+ * Map the cache file of the main font just loaded, unless the fontconfig
+ * setup changed since it was written: its version, configuration files
+ * or font directories.
+ */
+void
+fccload(void)
+{
+	FcStrList *list;
+	FcChar8 *name, *key;
+	struct stat st;
+	char *dir, *home;
+	int i, v = FcGetVersion();
+
+	/* what the previous font found goes to its own file */
+	if (fcc.nnew)
+		fccsave();
+	if (fcc.map)
+		munmap(fcc.map, fcc.maplen);
+	free(fcc.new);
+	memset(&fcc, 0, sizeof(fcc));
+
+	fcc.stamp = fcchash(0xcbf29ce484222325ULL, &v, sizeof(v));
+	for (i = 0; i < 2; i++) {
+		list = i ? FcConfigGetFontDirs(NULL) : FcConfigGetConfigFiles(NULL);
+		while ((name = FcStrListNext(list))) {
+			if (stat((char *)name, &st) < 0)
+				continue;
+			fcc.stamp = fcchash(fcc.stamp, name, strlen((char *)name));
+			fcc.stamp = fcchash(fcc.stamp, &st.st_mtime,
+					sizeof(st.st_mtime));
+		}
+		FcStrListDone(list);
+	}
+
+	if ((dir = getenv("XDG_CACHE_HOME")) && dir[0]) {
+		snprintf(fcc.path, sizeof(fcc.path), "%s/st", dir);
+	} else if ((home = getenv("HOME"))) {
+		snprintf(fcc.path, sizeof(fcc.path), "%s/.cache", home);
+		mkdir(fcc.path, 0700);
+		snprintf(fcc.path, sizeof(fcc.path), "%s/.cache/st", home);
+	} else {
+		return;
+	}
+	mkdir(fcc.path, 0700);
+	key = FcNameUnparse(dc.font.pattern);
+	snprintf(fcc.path + strlen(fcc.path), sizeof(fcc.path) - strlen(fcc.path),
+			"/fallback-%016llx", (unsigned long long)fcchash(
+			0xcbf29ce484222325ULL, key, strlen((char *)key)));
+	free(key);
+
+	fccmap();
+}
+
+/* Map the cache file, if it is one for the current fontconfig setup. */
+void
+fccmap(void)
+{
+	struct stat st;
+	Fccheader *h;
+	int fd, i;
+
+	if (fcc.map)
+		munmap(fcc.map, fcc.maplen);
+	fcc.map = NULL;
+	fcc.nrange = fcc.nstr = 0;
+
+	if ((fd = open(fcc.path, O_RDONLY)) < 0)
+		return;
+	if (fstat(fd, &st) < 0 || st.st_size < sizeof(*h)) {
+		close(fd);
+		return;
+	}
+	fcc.map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (fcc.map == MAP_FAILED) {
+		fcc.map = NULL;
+		return;
+	}
+	fcc.maplen = st.st_size;
+
+	h = (Fccheader *)fcc.map;
+	if (memcmp(h->magic, FCCMAGIC, sizeof(FCCMAGIC))
+			|| h->stamp != fcc.stamp || (uint64_t)h->nrange
+			* sizeof(Fccrange) + h->nstr + sizeof(*h) != st.st_size
+			|| !h->nstr || fcc.map[st.st_size - 1]) {
+		munmap(fcc.map, fcc.maplen);
+		fcc.map = NULL;
+		return;
+	}
+	fcc.range = (Fccrange *)(h + 1);
+	fcc.nrange = h->nrange;
+	fcc.str = (char *)(fcc.range + fcc.nrange);
+	fcc.nstr = h->nstr;
+	for (i = 0; i < fcc.nrange; i++) {
+		if (fcc.range[i].file >= fcc.nstr)
+			fcc.nrange = 0;
+	}
+}
+
+/* The file and face index of the fallback font of u in the cache. */
+char *
+fcclookup(Rune u, int flags, int *index)
+{
+	uint32_t lo = 0, hi = fcc.nrange, mid;
+	Fccrange *r;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		r = &fcc.range[mid];
+		if (r->flags < flags || (r->flags == flags && r->last < u))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == fcc.nrange)
+		return NULL;
+	r = &fcc.range[lo];
+	if (r->flags != flags || r->first > u)
+		return NULL;
+	*index = r->index;
+
+	return fcc.str + r->file;
+}
+
+static int
+fccrangecmp(const void *a, const void *b)
+{
+	const Fccrange *ra = a, *rb = b;
+
+	if (ra->flags != rb->flags)
+		return ra->flags < rb->flags ? -1 : 1;
+	if (ra->first != rb->first)
+		return ra->first < rb->first ? -1 : 1;
+	return 0;
+}
+
+/*
+ * Write the cache file anew with what was found since it was mapped,
+ * merging runes next to each other in the same font into ranges. It is
+ * renamed into place so that other sts see it whole or not at all.
+ */
+void
+fccsave(void)
+{
+	Fccheader h = { FCCMAGIC, fcc.stamp };
+	Fccrange *r;
+	char path[PATH_MAX + 8], *str;
+	size_t nstr = fcc.nstr, len;
+	uint32_t i, n, off;
+	FILE *f;
+	int fd, ok;
+
+	if (!fcc.path[0])
+		return;
+
+	r = xmalloc((fcc.nrange + fcc.nnew) * sizeof(*r));
+	for (len = nstr, i = 0; i < fcc.nnew; i++)
+		len += strlen(fcc.new[i].file) + 1;
+	str = xmalloc(len);
+	if (fcc.map) {
+		memcpy(r, fcc.range, fcc.nrange * sizeof(*r));
+		memcpy(str, fcc.str, nstr);
+	}
+
+	for (n = fcc.nrange, i = 0; i < fcc.nnew; i++) {
+		for (off = 0; off < nstr && strcmp(str + off, fcc.new[i].file);
+				off += strlen(str + off) + 1)
+			/* nothing */ ;
+		if (off == nstr) {
+			len = strlen(fcc.new[i].file) + 1;
+			memcpy(str + nstr, fcc.new[i].file, len);
+			nstr += len;
+		}
+		r[n++] = (Fccrange){ fcc.new[i].u, fcc.new[i].u,
+		                     fcc.new[i].flags, fcc.new[i].index, off };
+	}
+
+	qsort(r, n, sizeof(*r), fccrangecmp);
+	for (h.nrange = 0, i = 0; i < n; i++) {
+		if (h.nrange && r[h.nrange-1].flags == r[i].flags
+				&& r[i].first <= r[h.nrange-1].last + 1) {
+			/* the same rune twice, or the next one in the same font */
+			if (r[i].first <= r[h.nrange-1].last)
+				continue;
+			if (r[i].index == r[h.nrange-1].index
+					&& r[i].file == r[h.nrange-1].file) {
+				r[h.nrange-1].last = r[i].last;
+				continue;
+			}
+		}
+		r[h.nrange++] = r[i];
+	}
+	h.nstr = nstr;
+
+	snprintf(path, sizeof(path), "%s.XXXXXX", fcc.path);
+	if ((fd = mkstemp(path)) >= 0 && !(f = fdopen(fd, "w"))) {
+		close(fd);
+		unlink(path);
+	} else if (fd >= 0) {
+		ok = fwrite(&h, sizeof(h), 1, f) == 1
+		     && fwrite(r, sizeof(*r), h.nrange, f) == h.nrange
+		     && fwrite(str, 1, nstr, f) == nstr;
+		if (fclose(f) || !ok || rename(path, fcc.path) < 0)
+			unlink(path);
+	}
+	free(r);
+	free(str);
+
+	for (i = 0; i < fcc.nnew; i++)
+		free(fcc.new[i].file);
+	fcc.nnew = 0;
+	fccmap();
+}
+
+/*
+ * Copy the cell of u as drawn in font to x, y from the atlas, rendering it
+ * there first if its slot holds something else. The atlas is direct
+ * mapped: the slot is a hash of the key. Returns 0 if font lacks u.
+ */
+int
+wlatlasdraw(Font *font, int flags, Rune u, uint32_t fg, uint32_t bg,
+		int x, int y, int width)
+{
+	AtlasKey k = { u, flags | width << 2, fg, bg };
+	char buf[UTF_SIZ];
+	uint32_t h;
+	int i, ax, ay;
+
+	if (!atlas.buffer)
+		return 0;
+
+	h = (u * 2654435761U) ^ (fg * 40503U) ^ (bg * 2246822519U) ^ k.flags;
+	i = (h ^ h >> 16) % LEN(atlas.key);
+	ax = (i % ATLAS_COLS * 3 + 1) * wl.cw;
+	ay = (i / ATLAS_COLS * 2 + 1) * wl.ch;
+
+	if (memcmp(&atlas.key[i], &k, sizeof(k))) {
+		if (!wld_font_ensure_char(font->match, u))
+			return 0;
+		wld_set_target_buffer(wld.renderer, atlas.buffer);
+		wld_fill_rectangle(wld.renderer, bg, ax, ay, width * wl.cw,
+				wl.ch);
+		wld_draw_text(wld.renderer, font->match, fg, ax,
+				ay + font->ascent, buf, utf8encode(u, buf), NULL);
+		wld_set_target_buffer(wld.renderer, wld.buffer);
+		atlas.key[i] = k;
+	}
+	wld_copy_rectangle(wld.renderer, atlas.buffer, x, y, ax, ay,
+			width * wl.cw, wl.ch);
+
+	return 1;
+}
+
+/*
+ * Note the n cells from x on row y changed, with the borders wldraws
+ * clears along with them. Rows changed alike make one rectangle and what
+ * lies within another is left out.
+ */
+void
+wldamage(int x, int y, int n)
+{
+	Rect r = {
+		(x == 0) ? 0 : borderpx + x * wl.cw,
+		(y == 0) ? 0 : borderpx + y * wl.ch,
+		(x + n >= term.col) ? wl.w : borderpx + (x + n) * wl.cw,
+		(y >= term.row-1) ? wl.h : borderpx + (y + 1) * wl.ch
+	};
+	Rect *l;
+	Dirty *d;
+	int i;
+
+	/* the other buffers miss it until they are drawn into again */
+	for (i = 0; i < BUF_MAX && wld.pool[i]; i++) {
+		if (wld.pool[i] == wld.cur)
+			continue;
+		d = &wld.pool[i]->dirty[y];
+		d->x0 = MIN(d->x0, x);
+		d->x1 = MAX(d->x1, x + n - 1);
+	}
+
+	l = ndamage ? &damage[ndamage-1] : NULL;
+	if (l && l->x0 == r.x0 && l->x1 == r.x1 && l->y1 == r.y0) {
+		l->y1 = r.y1;
+		return;
+	}
+	for (i = 0; i < ndamage; i++) {
+		if (damage[i].x0 <= r.x0 && r.x1 <= damage[i].x1
+				&& damage[i].y0 <= r.y0 && r.y1 <= damage[i].y1)
+			return;
+	}
+
+	if (ndamage == damagesiz) {
+		damagesiz = MAX(2 * damagesiz, 16);
+		damage = xrealloc(damage, damagesiz * sizeof(*damage));
+	}
+	damage[ndamage++] = r;
+}
+
+/*
+ * TODO: Implement something like XftDrawGlyphFontSpec in wld, and then apply a
+ * similar patch to ae1923d27533ff46400d93765e971558201ca1ee
+ */
+
+void
+wldraws(char *s, Glyph base, int x, int y, int charlen, int bytelen)
+{
+	int winx = borderpx + x * wl.cw, winy = borderpx + y * wl.ch,
+	    width = charlen * wl.cw, xp, i;
+	int frcflags;
+	int u8fl, u8fblen, u8cblen, doesexist, cells;
+	char *u8c, *u8fs;
+	Rune unicodep;
+	Font *font = &dc.font;
+	uint32_t fg, bg, temp;
+	uint32_t basefg = styles[base.style].fg, basebg = styles[base.style].bg;
+	int oneatatime;
+
+	frcflags = FRC_NORMAL;
+
+	/* Fallback on color display for attributes not supported by the font */
+	if (base.mode & ATTR_ITALIC && base.mode & ATTR_BOLD) {
+		if (dc.ibfont.badslant || dc.ibfont.badweight)
+			basefg = defaultattr;
+		font = &dc.ibfont;
+		frcflags = FRC_ITALICBOLD;
+	} else if (base.mode & ATTR_ITALIC) {
+		if (dc.ifont.badslant)
+			basefg = defaultattr;
+		font = &dc.ifont;
+		frcflags = FRC_ITALIC;
+	} else if (base.mode & ATTR_BOLD) {
+		if (dc.bfont.badweight)
+			basefg = defaultattr;
+		font = &dc.ifont;
+		frcflags = FRC_BOLD;
+	}
+
+	if (IS_TRUECOL(basefg)) {
+		fg = basefg | 0xff000000;
+	} else {
+		fg = dc.col[basefg];
+	}
+
+	if (IS_TRUECOL(basebg)) {
+		bg = basebg | 0xff000000;
+	} else {
+		bg = dc.col[basebg];
+	}
+
+	if (base.mode & ATTR_BOLD) {
+		/*
+		 * change basic system colors [0-7]
+		 * to bright system colors [8-15]
+		 */
+		if (BETWEEN(basefg, 0, 7) && !(base.mode & ATTR_FAINT))
+			fg = dc.col[basefg + 8];
+
+		if (base.mode & ATTR_ITALIC) {
+			font = &dc.ibfont;
+			frcflags = FRC_ITALICBOLD;
+		} else {
+			font = &dc.bfont;
+			frcflags = FRC_BOLD;
+		}
+	}
+
+	if (IS_SET(MODE_REVERSE)) {
+		if (fg == dc.col[defaultfg]) {
+			fg = dc.col[defaultbg];
+		} else {
+			fg = ~(fg & 0xffffff);
+		}
+
+		if (bg == dc.col[defaultbg]) {
+			bg = dc.col[defaultfg];
+		} else {
+			bg = ~(bg & 0xffffff);
+		}
+	}
+
+	if (base.mode & ATTR_REVERSE) {
+		temp = fg;
+		fg = bg;
+		bg = temp;
+	}
+
+	if (base.mode & ATTR_FAINT && !(base.mode & ATTR_BOLD)) {
+		fg = (fg & (0xff << 24))
+			| ((((fg >> 16) & 0xff) / 2) << 16)
+			| ((((fg >> 8) & 0xff) / 2) << 8)
+			| ((fg & 0xff) / 2);
+	}
+
+	if (base.mode & ATTR_BLINK && term.mode & MODE_BLINK)
+		fg = bg;
+
+	if (base.mode & ATTR_INVISIBLE)
+		fg = bg;
+
+	/* Intelligent cleaning up of the borders. */
+	if (x == 0) {
+		wlclear(0, (y == 0)? 0 : winy, borderpx,
+			((y >= term.row-1)? wl.h : (winy + wl.ch)));
+	}
+	if (x + charlen >= term.col) {
+		wlclear(winx + width, (y == 0)? 0 : winy, wl.w,
+			((y >= term.row-1)? wl.h : (winy + wl.ch)));
+	}
+	if (y == 0)
+		wlclear(winx, 0, winx + width, borderpx);
+	if (y == term.row-1)
+		wlclear(winx, winy + wl.ch, winx + width, wl.h);
+
+	/* Clean up the region we want to draw to. */
+	wld_fill_rectangle(wld.renderer, bg, winx, winy, width, wl.ch);
+
+	cells = (base.mode & ATTR_WIDE) ? 2 : 1;
+	for (xp = winx; bytelen > 0;) {
+		/* most chars are in the atlas already */
+		u8cblen = utf8decode(s, &unicodep, UTF_SIZ);
+		if (wlatlasdraw(font, frcflags, unicodep, fg, bg, xp, winy,
+				cells)) {
+			s += u8cblen;
+			bytelen -= u8cblen;
+			xp += wl.cw * cells;
+			continue;
+		}
+
+		/*
+		 * Search for the range in the to be printed string of glyphs
+		 * that are in the main font. Then print that range. If
+		 * some glyph is found that is not in the font, do the
+		 * fallback dance.
+		 */
+		u8fs = s;
+		u8fblen = 0;
+		u8fl = 0;
+		oneatatime = font->width != wl.cw;
+		for (;;) {
+			u8c = s;
+			u8cblen = utf8decode(s, &unicodep, UTF_SIZ);
+			s += u8cblen;
+			bytelen -= u8cblen;
+
+			doesexist = wld_font_ensure_char(font->match, unicodep);
+			if (doesexist) {
+					u8fl++;
+					u8fblen += u8cblen;
+					if (!oneatatime && bytelen > 0)
+							continue;
+			}
+
+			if (u8fl > 0) {
+				wld_draw_text(wld.renderer,
+						font->match, fg, xp,
+						winy + font->ascent,
+						u8fs, u8fblen, NULL);
+				xp += wl.cw * u8fl;
+			}
+			break;
+		}
+		if (doesexist) {
+			if (oneatatime)
+				continue;
+			break;
+		}
+
+		/* until its fallback font is found, the main one draws notdef */
+		if ((i = frcfont(font, frcflags, unicodep)) < 0) {
+			wld_draw_text(wld.renderer, font->match, fg,
+					xp, winy + font->ascent,
+					u8c, u8cblen, NULL);
+		} else {
+			wld_draw_text(wld.renderer, frc[i].font, fg,
+					xp, winy + frc[i].font->ascent,
+					u8c, u8cblen, NULL);
+		}
+
+		xp += wl.cw * runewidth(unicodep);
+	}
+
+	if (base.mode & ATTR_UNDERLINE) {
+		wld_fill_rectangle(wld.renderer, fg, winx, winy + font->ascent + 1,
+				width, 1);
+	}
+
+	if (base.mode & ATTR_STRUCK) {
+		wld_fill_rectangle(wld.renderer, fg, winx, winy + 2 * font->ascent / 3,
+				width, 1);
+	}
+}
+
+void
+wldrawglyph(Glyph g, int x, int y)
+{
+	static char buf[UTF_SIZ];
+	size_t len = utf8encode(g.u, buf);
+	int width = g.mode & ATTR_WIDE ? 2 : 1;
+
+	wldraws(buf, g, x, y, width, len);
+}
+
+void
+wldrawcursor(void)
+{
+	static int oldx = 0, oldy = 0;
+	int curx;
+	Glyph g = {' ', ATTR_NULL}, og;
+	int ena_sel = sel.ob.x != -1 && sel.alt == IS_SET(MODE_ALTSCREEN);
+	uint32_t fg = defaultbg, bg = defaultcs, drawcol;
+
+	/* it is hidden while history is shown */
+	if (term.scroll)
+		return;
+
+	LIMIT(oldx, 0, term.col-1);
+	LIMIT(oldy, 0, term.row-1);
+
+	curx = term.c.x;
+
+	/* adjust position if in dummy */
+	if (term.line[oldy][oldx].mode & ATTR_WDUMMY)
+		oldx--;
+	if (term.line[term.c.y][curx].mode & ATTR_WDUMMY)
+		curx--;
+
+	/* remove the old cursor */
+	og = term.line[oldy][oldx];
+	if (ena_sel && selected(oldx, oldy))
+		og.mode ^= ATTR_REVERSE;
+	wldrawglyph(og, oldx, oldy);
+	wldamage(oldx, oldy, (og.mode & ATTR_WIDE) ? 2 : 1);
+
+	g.u = term.line[term.c.y][term.c.x].u;
+
+	/*
+	 * Select the right color for the right mode.
+	 */
+	if (IS_SET(MODE_REVERSE)) {
+		g.mode |= ATTR_REVERSE;
+		bg = defaultfg;
+		if (ena_sel && selected(term.c.x, term.c.y)) {
+			drawcol = dc.col[defaultcs];
+			fg = defaultrcs;
+		} else {
+			drawcol = dc.col[defaultrcs];
+			fg = defaultcs;
+		}
+	} else {
+		if (ena_sel && selected(term.c.x, term.c.y)) {
+			drawcol = dc.col[defaultrcs];
+			fg = defaultfg;
+			bg = defaultrcs;
+		} else {
+			drawcol = dc.col[defaultcs];
+		}
+	}
+	g.style = tstyle(fg, bg);
+
+	if (IS_SET(MODE_HIDE))
+		return;
+
+	/* draw the new one */
+	if (wl.state & WIN_FOCUSED) {
+		switch (wl.cursor) {
+		case 7: /* st extension: snowman */
+			utf8decode("☃", &g.u, UTF_SIZ);
+		case 0: /* Blinking Block */
+		case 1: /* Blinking Block (Default) */
+		case 2: /* Steady Block */
+			g.mode |= term.line[term.c.y][curx].mode & ATTR_WIDE;
+			wldrawglyph(g, term.c.x, term.c.y);
+			break;
+		case 3: /* Blinking Underline */
+		case 4: /* Steady Underline */
+			wld_fill_rectangle(wld.renderer, drawcol,
+					borderpx + curx * wl.cw,
+					borderpx + (term.c.y + 1) * wl.ch - \
+						cursorthickness,
+					wl.cw, cursorthickness);
+			break;
+		case 5: /* Blinking bar */
+		case 6: /* Steady bar */
+			wld_fill_rectangle(wld.renderer, drawcol,
+					borderpx + curx * wl.cw,
+					borderpx + term.c.y * wl.ch,
+					cursorthickness, wl.ch);
+			break;
+		}
+	} else {
+		wld_fill_rectangle(wld.renderer, drawcol,
+				borderpx + curx * wl.cw,
+				borderpx + term.c.y * wl.ch,
+				wl.cw - 1, 1);
+		wld_fill_rectangle(wld.renderer, drawcol,
+				borderpx + curx * wl.cw,
+				borderpx + term.c.y * wl.ch,
+				1, wl.ch - 1);
+		wld_fill_rectangle(wld.renderer, drawcol,
+				borderpx + (curx + 1) * wl.cw - 1,
+				borderpx + term.c.y * wl.ch,
+				1, wl.ch - 1);
+		wld_fill_rectangle(wld.renderer, drawcol,
+				borderpx + curx * wl.cw,
+				borderpx + (term.c.y + 1) * wl.ch - 1,
+				wl.cw, 1);
+	}
+	wldamage(curx, term.c.y, (g.mode & ATTR_WIDE) ? 2 : 1);
+	oldx = curx, oldy = term.c.y;
+}
+
+void
+wlsettitle(char *title)
+{
+	xdg_surface_set_title(wl.xdgsurface, title);
+}
+
+void
+wlresettitle(void)
+{
+	wlsettitle(opt_title ? opt_title : "st");
+}
+
+void
+redraw(void)
+{
+	tfulldirt();
+}
+
+void
+draw(void)
+{
+	Rect *r;
+	int i;
+
+	/* all are still shown, bufrelease draws when one is not */
+	if (!(wld.cur = bufget()))
+		return;
+
+	wld.buffer = wld.cur->wld;
+	wld_set_target_buffer(wld.renderer, wld.buffer);
+	drawregion(0, 0, term.col, term.row);
+	for (i = 0; i < ndamage; i++) {
+		r = &damage[i];
+		if (wl.damagebuffer) {
+			wl_surface_damage_buffer(wl.surface, r->x0, r->y0,
+					r->x1 - r->x0, r->y1 - r->y0);
+		} else {
+			wl_surface_damage(wl.surface, r->x0, r->y0,
+					r->x1 - r->x0, r->y1 - r->y0);
+		}
+	}
+	ndamage = 0;
+	wl.framecb = wl_surface_frame(wl.surface);
+	wl_callback_add_listener(wl.framecb, &framelistener, NULL);
+	wld_flush(wld.renderer);
+	wl_surface_attach(wl.surface, wld.cur->wl, 0, 0);
+	wl_surface_commit(wl.surface);
+	wld.cur->busy = true;
+	wld.cur->frame = ++wld.frame;
+	needdraw = false;
+}
+
+void
+drawregion(int x1, int y1, int x2, int y2)
+{
+	int ic, ib, x, y, ox;
+	Glyph base, new;
+	Dirty d, m;
+	char buf[DRAW_BUF_SIZ];
+	int ena_sel = sel.ob.x != -1 && sel.alt == IS_SET(MODE_ALTSCREEN);
+
+	for (y = y1; y < y2; y++) {
+		d = term.dirty[y];
+		m = wld.cur->dirty[y];
+		term.dirty[y] = wld.cur->dirty[y] = (Dirty){ term.col, -1 };
+
+		/* only redraw the dirty columns, with whole wide chars */
+		if (d.x0 <= d.x1) {
+			if (d.x0 > 0 && TLINE(y)[d.x0].mode & ATTR_WDUMMY)
+				d.x0--;
+			if (d.x1 < term.col-1 && TLINE(y)[d.x1].mode & ATTR_WIDE)
+				d.x1++;
+			d.x0 = MAX(d.x0, x1);
+			d.x1 = MIN(d.x1, x2-1);
+			if (d.x0 <= d.x1)
+				wldamage(d.x0, y, d.x1 - d.x0 + 1);
+		}
+
+		/* and what the buffer missed of the frames drawn since */
+		d.x0 = MAX(MIN(d.x0, m.x0), x1);
+		d.x1 = MIN(MAX(d.x1, m.x1), x2-1);
+		if (d.x1 < d.x0)
+			continue;
+
+		base = TLINE(y)[d.x0];
+		ic = ib = ox = 0;
+		for (x = d.x0; x <= d.x1; x++) {
+			new = TLINE(y)[x];
+			if (new.mode & ATTR_WDUMMY)
+				continue;
+			if (ena_sel && selected(x, y))
+				new.mode ^= ATTR_REVERSE;
+			if (ib > 0 && (ATTRCMP(base, new)
+					|| ib >= DRAW_BUF_SIZ-UTF_SIZ)) {
+				wldraws(buf, base, ox, y, ic, ib);
+				ic = ib = 0;
+			}
+			if (ib == 0) {
+				ox = x;
+				base = new;
+			}
+
+			ib += utf8encode(new.u, buf+ib);
+			ic += (new.mode & ATTR_WIDE)? 2 : 1;
+		}
+		if (ib > 0)
+			wldraws(buf, base, ox, y, ic, ib);
+	}
+	wldrawcursor();
+}
+
+void
+wlseturgency(int add)
+{
+	/* XXX: no urgency equivalent yet in wayland */
+}
+
+void
+wlbell(void)
+{
+	if (!(wl.state & WIN_FOCUSED))
+		wlseturgency(1);
+	/* XXX: No bell on wayland
+	 * if (bellvolume)
+	 *     XkbBell(xw.dpy, xw.win, bellvolume, (Atom)NULL);
+	 */
+}
+
+void
+wlsetcursor(int cursor)
+{
+	wl.cursor = cursor;
+}
+
+int
+match(uint mask, uint state)
+{
+	return mask == MOD_MASK_ANY || mask == (state & ~(ignoremod));
+}
+
+void
+numlock(const Arg *dummy)
+{
+	term.numlock ^= 1;
+}
+
+char*
+kmap(xkb_keysym_t k, uint state)
+{
+	Key *kp;
+	int i;
+
+	/* Check for mapped keys out of X11 function keys. */
+	for (i = 0; i < LEN(mappedkeys); i++) {
+		if (mappedkeys[i] == k)
+			break;
+	}
+	if (i == LEN(mappedkeys)) {
+		if ((k & 0xFFFF) < 0xFD00)
+			return NULL;
+	}
+
+	for (kp = key; kp < key + LEN(key); kp++) {
+		if (kp->k != k)
+			continue;
+
+		if (!match(kp->mask, state))
+			continue;
+
+		if (IS_SET(MODE_APPKEYPAD) ? kp->appkey < 0 : kp->appkey > 0)
+			continue;
+		if (term.numlock && kp->appkey == 2)
+			continue;
+
+		if (IS_SET(MODE_APPCURSOR) ? kp->appcursor < 0 : kp->appcursor > 0)
+			continue;
+
+		if (IS_SET(MODE_CRLF) ? kp->crlf < 0 : kp->crlf > 0)
+			continue;
+
+		return kp->s;
+	}
+
+	return NULL;
+}
+
+void
+cresize(int width, int height)
+{
+	int col, row;
+
+	if (width != 0)
+		wl.w = width;
+	if (height != 0)
+		wl.h = height;
+
+	col = (wl.w - 2 * borderpx) / wl.cw;
+	row = (wl.h - 2 * borderpx) / wl.ch;
+
+	tresize(col, row);
+	wlresize(col, row);
+}
+
+void
+regglobal(void *data, struct wl_registry *registry, uint32_t name,
+          const char *interface, uint32_t version)
+{
+	if (strcmp(interface, "wl_compositor") == 0) {
+		/* damage_buffer came with version 4 */
+		wl.cmp = wl_registry_bind(registry, name,
+				&wl_compositor_interface, MIN(version, 4));
+		wl.damagebuffer = version >= 4;
+	} else if (strcmp(interface, "xdg_shell") == 0) {
+		wl.shell = wl_registry_bind(registry, name,
+				&xdg_shell_interface, 1);
+		xdg_shell_add_listener(wl.shell, &xdgshelllistener, NULL);
+		xdg_shell_use_unstable_version(wl.shell,
+				XDG_SHELL_VERSION_CURRENT);
+	} else if (strcmp(interface, "wl_shm") == 0) {
+		wl.shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+	} else if (strcmp(interface, "wl_seat") == 0) {
+		wl.seat = wl_registry_bind(registry, name,
+				&wl_seat_interface, 4);
+	} else if (strcmp(interface, "wl_data_device_manager") == 0) {
+		wl.datadevmanager = wl_registry_bind(registry, name,
+				&wl_data_device_manager_interface, 1);
+	} else if (strcmp(interface, "wl_output") == 0) {
+		/* bind to outputs so we can get surface enter events */
+		wl_registry_bind(registry, name, &wl_output_interface, 2);
+	}
+}
+
+void
+regglobalremove(void *data, struct wl_registry *registry, uint32_t name)
+{
+}
+
+void
+surfenter(void *data, struct wl_surface *surface, struct wl_output *output)
+{
+	wl.vis++;
+	if (!(wl.state & WIN_VISIBLE))
+		wl.state |= WIN_VISIBLE;
+}
+
+void
+surfleave(void *data, struct wl_surface *surface, struct wl_output *output)
+{
+	if (--wl.vis == 0)
+		wl.state &= ~WIN_VISIBLE;
+}
+
+void
+framedone(void *data, struct wl_callback *callback, uint32_t msecs)
+{
+	wl_callback_destroy(callback);
+	wl.framecb = NULL;
+	if (needdraw && wl.state & WIN_VISIBLE) {
+		draw();
+	}
+}
+
+void
+bufrelease(void *data, struct wl_buffer *buffer)
+{
+	Buffer *b = data;
+
+	if (b->gone) {
+		buffree(b);
+		return;
+	}
+	b->busy = false;
+	/* a frame may have waited for it */
+	if (needdraw && wl.state & WIN_VISIBLE && !wl.framecb)
+		draw();
+}
+
+void
+kbdkeymap(void *data, struct wl_keyboard *keyboard, uint32_t format, int32_t fd,
+          uint32_t size)
+{
+	char *string;
+
+	if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1) {
+		close(fd);
+		return;
+	}
+
+	string = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+	if (string == MAP_FAILED) {
+		close(fd);
+		return;
+	}
+
+	wl.xkb.keymap = xkb_keymap_new_from_string(wl.xkb.ctx, string,
+			XKB_KEYMAP_FORMAT_TEXT_V1, 0);
+	munmap(string, size);
+	close(fd);
+	wl.xkb.state = xkb_state_new(wl.xkb.keymap);
+
+	wl.xkb.ctrl = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_CTRL);
+	wl.xkb.alt = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_ALT);
+	wl.xkb.shift = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_SHIFT);
+	wl.xkb.logo = xkb_keymap_mod_get_index(wl.xkb.keymap, XKB_MOD_NAME_LOGO);
+
+	wl.xkb.mods = 0;
+}
+
+void
+kbdenter(void *data, struct wl_keyboard *keyboard, uint32_t serial,
+         struct wl_surface *surface, struct wl_array *keys)
+{
+	wl.state |= WIN_FOCUSED;
+	if (IS_SET(MODE_FOCUS))
+		ttywrite("\033[I", 3);
+	/* need to redraw the cursor */
+	needdraw = true;
+}
+
+void
+kbdleave(void *data, struct wl_keyboard *keyboard, uint32_t serial,
+	 struct wl_surface *surface)
+{
+	/* selection offers are invalidated when we lose keyboard focus */
+	wl.seloffer = NULL;
+	wl.state &= ~WIN_FOCUSED;
+	if (IS_SET(MODE_FOCUS))
+		ttywrite("\033[O", 3);
+	/* need to redraw the cursor */
+	needdraw = true;
+	/* disable key repeat */
+	repeat.len = 0;
+}
+
+void
+kbdkey(void *data, struct wl_keyboard *keyboard, uint32_t serial, uint32_t time,
+       uint32_t key, uint32_t state)
+{
+	xkb_keysym_t ksym;
+	char buf[32], *str;
+	int len;
+	Rune c;
+	Shortcut *bp;
+
+	wl.serial = serial;
+	if (IS_SET(MODE_KBDLOCK))
+		return;
+
+	if (state == WL_KEYBOARD_KEY_STATE_RELEASED) {
+		if (repeat.key == key)
+			repeat.len = 0;
+		return;
+	}
+
+	ksym = xkb_state_key_get_one_sym(wl.xkb.state, key + 8);
+	len = xkb_keysym_to_utf8(ksym, buf, sizeof buf);
+	if (len > 0)
+	    --len;
+
+	/* 1. shortcuts */
+	for (bp = shortcuts; bp < shortcuts + LEN(shortcuts); bp++) {
+		if (ksym == bp->keysym && match(bp->mod, wl.xkb.mods)) {
+			bp->func(&(bp->arg));
+			return;
+		}
+	}
+
+	/* 2. custom keys from config.h */
+	if ((str = kmap(ksym, wl.xkb.mods))) {
+		len = strlen(str);
+		goto send;
+	}
+
+	/* 3. composed string from input method */
+	if (len == 0)
+		return;
+	if (len == 1 && wl.xkb.mods & MOD_MASK_ALT) {
+		if (IS_SET(MODE_8BIT)) {
+			if (*buf < 0177) {
+				c = *buf | 0x80;
+				len = utf8encode(c, buf);
+			}
+		} else {
+			buf[1] = buf[0];
+			buf[0] = '\033';
+			len = 2;
+		}
+	}
+	/* convert character to control character */
+	else if (len == 1 && wl.xkb.mods & MOD_MASK_CTRL) {
+		if ((*buf >= '@' && *buf < '\177') || *buf == ' ')
+			*buf &= 0x1F;
+		else if (*buf == '2') *buf = '\000';
+		else if (*buf >= '3' && *buf <= '7')
+			*buf -= ('3' - '\033');
+		else if (*buf == '8') *buf = '\177';
+		else if (*buf == '/') *buf = '_' & 0x1F;
+	}
+
+	str = buf;
+
+send:
+	memcpy(repeat.str, str, len);
+	repeat.key = key;
+	repeat.len = len;
+	repeat.started = false;
+	clock_gettime(CLOCK_MONOTONIC, &repeat.last);
+	tsetview(0);
+	ttysend(str, len);
+}
+
+void
+kbdmodifiers(void *data, struct wl_keyboard *keyboard, uint32_t serial,
+             uint32_t dep, uint32_t lat, uint32_t lck, uint32_t group)
+{
+	xkb_mod_mask_t mod_mask;
+
+	xkb_state_update_mask(wl.xkb.state, dep, lat, lck, group, 0, 0);
+
+	mod_mask = xkb_state_serialize_mods(wl.xkb.state, XKB_STATE_MODS_EFFECTIVE);
+	wl.xkb.mods = 0;
+
+	if (mod_mask & (1 << wl.xkb.ctrl))
+		wl.xkb.mods |= MOD_MASK_CTRL;
+	if (mod_mask & (1 << wl.xkb.alt))
+		wl.xkb.mods |= MOD_MASK_ALT;
+	if (mod_mask & (1 << wl.xkb.shift))
+		wl.xkb.mods |= MOD_MASK_SHIFT;
+	if (mod_mask & (1 << wl.xkb.logo))
+		wl.xkb.mods |= MOD_MASK_LOGO;
+}
+
+void
+kbdrepeatinfo(void *data, struct wl_keyboard *keyboard, int32_t rate,
+              int32_t delay)
+{
+	keyrepeatdelay = delay;
+	keyrepeatinterval = 1000 / rate;
+}
+
+void
+ptrenter(void *data, struct wl_pointer *pointer, uint32_t serial,
+         struct wl_surface *surface, wl_fixed_t x, wl_fixed_t y)
+{
+	struct wl_cursor_image *img = cursor.cursor->images[0];
+	struct wl_buffer *buffer;
+
+	wl_pointer_set_cursor(pointer, serial, cursor.surface,
+			img->hotspot_x, img->hotspot_y);
+	buffer = wl_cursor_image_get_buffer(img);
+	wl_surface_attach(cursor.surface, buffer, 0, 0);
+	wl_surface_damage(cursor.surface, 0, 0, img->width, img->height);
+	wl_surface_commit(cursor.surface);
+}
+
+void
+ptrleave(void *data, struct wl_pointer *pointer, uint32_t serial,
+         struct wl_surface *surface)
+{
+}
+
+void
+ptrmotion(void *data, struct wl_pointer * pointer, uint32_t serial,
+          wl_fixed_t x, wl_fixed_t y)
+{
+	int oldey, oldex, oldsby, oldsey;
+
+	if (IS_SET(MODE_MOUSE)) {
+		wlmousereportmotion(x, y);
+		return;
+	}
+
+	wl.px = wl_fixed_to_int(x);
+	wl.py = wl_fixed_to_int(y);
+
+	if (!sel.mode)
+		return;
+
+	sel.mode = SEL_READY;
+	oldey = sel.oe.y;
+	oldex = sel.oe.x;
+	oldsby = sel.nb.y;
+	oldsey = sel.ne.y;
+	getbuttoninfo();
+
+	if (oldey != sel.oe.y || oldex != sel.oe.x)
+		tsetdirt(MIN(sel.nb.y, oldsby), MAX(sel.ne.y, oldsey));
+}
+
+void
+ptrbutton(void * data, struct wl_pointer * pointer, uint32_t serial,
+          uint32_t time, uint32_t button, uint32_t state)
+{
+	MouseShortcut *ms;
+
+	wl.serial = serial;
+	if (IS_SET(MODE_MOUSE) && !(wl.xkb.mods & forceselmod)) {
+		wlmousereportbutton(button, state);
+		return;
+	}
+
+	switch (state) {
+	case WL_POINTER_BUTTON_STATE_RELEASED:
+		if (button == BTN_MIDDLE) {
+			selpaste(NULL);
+		} else if (button == BTN_LEFT) {
+			if (sel.mode == SEL_READY) {
+				getbuttoninfo();
+				selcopy();
+			} else
+				selclear();
+			sel.mode = SEL_IDLE;
+			tsetdirt(sel.nb.y, sel.ne.y);
+		}
+		break;
+
+	case WL_POINTER_BUTTON_STATE_PRESSED:
+		for (ms = mshortcuts; ms < mshortcuts + LEN(mshortcuts); ms++) {
+			if (button == ms->b && match(ms->mask, wl.xkb.mods)) {
+				ttysend(ms->s, strlen(ms->s));
+				return;
+			}
+		}
+
+		if (button == BTN_LEFT) {
+			/* Clear previous selection, logically and visually. */
+			selclear();
+			sel.mode = SEL_EMPTY;
+			sel.type = SEL_REGULAR;
+			sel.oe.x = sel.ob.x = x2col(wl.px);
+			sel.oe.y = sel.ob.y = y2row(wl.py);
+
+			/*
+			 * If the user clicks below predefined timeouts
+			 * specific snapping behaviour is exposed.
+			 */
+			if (time - wlsel.tclick2 <= tripleclicktimeout) {
+				sel.snap = SNAP_LINE;
+			} else if (time - wlsel.tclick1 <= doubleclicktimeout) {
+				sel.snap = SNAP_WORD;
+			} else {
+				sel.snap = 0;
+			}
+			selnormalize();
+
+			if (sel.snap != 0)
+				sel.mode = SEL_READY;
+			tsetdirt(sel.nb.y, sel.ne.y);
+			wlsel.tclick2 = wlsel.tclick1;
+			wlsel.tclick1 = time;
+		}
+		break;
+	}
+}
+
+void
+ptraxis(void * data, struct wl_pointer * pointer, uint32_t time, uint32_t axis,
+        wl_fixed_t value)
+{
+	Axiskey *ak;
+	int dir = value > 0 ? +1 : -1;
+
+	if (IS_SET(MODE_MOUSE) && !(wl.xkb.mods & forceselmod)) {
+		wlmousereportaxis(axis, value);
+		return;
+	}
+
+	for (ak = ashortcuts; ak < ashortcuts + LEN(ashortcuts); ak++) {
+		if (axis == ak->axis && dir == ak->dir
+				&& match(ak->mask, wl.xkb.mods)) {
+			if (ak->func)
+				ak->func(&(ak->arg));
+			else
+				ttysend(ak->s, strlen(ak->s));
+			return;
+		}
+	}
+}
+
+void
+xdgshellping(void *data, struct xdg_shell *shell, uint32_t serial)
+{
+	xdg_shell_pong(shell, serial);
+}
+
+void
+xdgsurfconfigure(void *data, struct xdg_surface *surf, int32_t w, int32_t h,
+                 struct wl_array *states, uint32_t serial)
+{
+	xdg_surface_ack_configure(surf, serial);
+	if (w == wl.w && h == wl.h)
+		return;
+	cresize(w, h);
+	if (wl.configured)
+		ttyresize(wl.tw, wl.th);
+	else
+		wl.configured = true;
+}
+
+void
+xdgsurfclose(void *data, struct xdg_surface *surf)
+{
+	ttyhangup();
+	exit(0);
+}
+
+void
+datadevoffer(void *data, struct wl_data_device *datadev,
+             struct wl_data_offer *offer)
+{
+	wl_data_offer_add_listener(offer, &dataofferlistener, NULL);
+}
+
+void
+datadeventer(void *data, struct wl_data_device *datadev, uint32_t serial,
+		struct wl_surface *surf, wl_fixed_t x, wl_fixed_t y,
+		struct wl_data_offer *offer)
+{
+}
+
+void
+datadevleave(void *data, struct wl_data_device *datadev)
+{
+}
+
+void
+datadevmotion(void *data, struct wl_data_device *datadev, uint32_t time,
+              wl_fixed_t x, wl_fixed_t y)
+{
+}
+
+void
+datadevdrop(void *data, struct wl_data_device *datadev)
+{
+}
+
+void
+datadevselection(void *data, struct wl_data_device *datadev,
+                 struct wl_data_offer *offer)
+{
+	if (offer && (uintptr_t) wl_data_offer_get_user_data(offer) == 1)
+		wl.seloffer = offer;
+	else
+		wl.seloffer = NULL;
+}
+
+void
+dataofferoffer(void *data, struct wl_data_offer *offer, const char *mimetype)
+{
+	/* mark the offer as usable if it supports plain text */
+	if (strncmp(mimetype, "text/plain", 10) == 0)
+		wl_data_offer_set_user_data(offer, (void *)(uintptr_t) 1);
+}
+
+void
+datasrctarget(void *data, struct wl_data_source *source, const char *mimetype)
+{
+}
+
+void
+datasrcsend(void *data, struct wl_data_source *source, const char *mimetype,
+            int32_t fd)
+{
+	char *buf = wlsel.primary;
+	int len = strlen(wlsel.primary);
+	ssize_t ret;
+	while ((ret = write(fd, buf, MIN(len, BUFSIZ))) > 0) {
+		len -= ret;
+		buf += ret;
+	}
+	close(fd);
+}
+
+void
+datasrccancelled(void *data, struct wl_data_source *source)
+{
+	if (wlsel.source == source) {
+		wlsel.source = NULL;
+		selclear();
+	}
+	wl_data_source_destroy(source);
+}
+
+void
+run(void)
+{
+	fd_set rfd;
+	int wlfd = wl_display_get_fd(wl.dpy), blinkset = 0;
+	struct timespec drawtimeout, *tv = NULL, now, last, lastblink;
+	ulong msecs;
+
+	/* Look for initial configure. */
+	wl_display_roundtrip(wl.dpy);
+	if (!wl.configured)
+		cresize(wl.w, wl.h);
+	if (opt_rec)
+		ttyrecord(opt_rec);
+	if (opt_play)
+		ttyreplay(opt_play, opt_realtime);
+	else
+		ttynew(opt_line, opt_io, opt_cmd);
+	ttyresize(wl.tw, wl.th);
+	draw();
+
+	clock_gettime(CLOCK_MONOTONIC, &last);
+	lastblink = last;
+
+	for (;;) {
+		FD_ZERO(&rfd);
+		FD_SET(cmdfd, &rfd);
+		FD_SET(wlfd, &rfd);
+		if (fcfrom[0] >= 0)
+			FD_SET(fcfrom[0], &rfd);
+
+		if (pselect(MAX(MAX(wlfd, cmdfd), fcfrom[0])+1, &rfd, NULL, NULL,
+				tv, NULL) < 0) {
+			if (errno == EINTR)
+				continue;
+			die("select failed: %s\n", strerror(errno));
+		}
+
+		if (FD_ISSET(cmdfd, &rfd)) {
+			ttyread();
+			if (blinktimeout) {
+				blinkset = tblinking();
+				if (!blinkset)
+					MODBIT(term.mode, 0, MODE_BLINK);
+			}
+		}
+
+		if (FD_ISSET(wlfd, &rfd)) {
+			if (wl_display_dispatch(wl.dpy) == -1)
+				die("Connection error\n");
+		}
+
+		if (fcfrom[0] >= 0 && FD_ISSET(fcfrom[0], &rfd))
+			frcresolved();
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		msecs = -1;
+
+		if (blinkset && blinktimeout) {
+			if (TIMEDIFF(now, lastblink) >= blinktimeout) {
+				tsetdirtblink();
+				term.mode ^= MODE_BLINK;
+				lastblink = now;
+			} else {
+				msecs = MIN(msecs, blinktimeout - \
+						TIMEDIFF(now, lastblink));
+			}
+		}
+		if (repeat.len > 0) {
+			if (TIMEDIFF(now, repeat.last) >= \
+				(repeat.started ? keyrepeatinterval : \
+					keyrepeatdelay)) {
+				repeat.started = true;
+				repeat.last = now;
+				ttysend(repeat.str, repeat.len);
+			} else {
+				msecs = MIN(msecs, (repeat.started ? \
+					keyrepeatinterval : keyrepeatdelay) - \
+					TIMEDIFF(now, repeat.last));
+			}
+		}
+
+		if (needdraw && wl.state & WIN_VISIBLE) {
+			if (!wl.framecb) {
+				draw();
+			}
+		}
+
+		if (msecs == -1) {
+			tv = NULL;
+		} else {
+			drawtimeout.tv_nsec = 1E6 * msecs;
+			drawtimeout.tv_sec = 0;
+			tv = &drawtimeout;
+		}
+
+		wl_display_dispatch_pending(wl.dpy);
+		wl_display_flush(wl.dpy);
+	}
+}
+
+void
+usage(void)
+{
+	die("usage: %s [-aiv] [-c class] [-f font] [-g geometry]"
+	    " [-n name] [-o file]\n"
+	    "          [-r file] [-T title] [-t title] [-w windowid]"
+	    " [[-e] command [args ...]]\n"
+	    "       %s [-aiv] [-c class] [-f font] [-g geometry]"
+	    " [-n name] [-o file]\n"
+	    "          [-r file] [-T title] [-t title] [-w windowid] -l line"
+	    " [stty_args ...]\n"
+	    "       %s [-aiv] [-c class] [-f font] [-g geometry]"
+	    " [-n name] [-o file]\n"
+	    "          [-r file] [-T title] [-t title] [-w windowid]"
+	    " -p | -P recording\n", argv0, argv0, argv0);
+}
+
+int
+main(int argc, char *argv[])
+{
+	wl.cursor = cursorshape;
+
+	ARGBEGIN {
+	case 'a':
+		allowaltscreen = 0;
+		break;
+	case 'c':
+		opt_class = EARGF(usage());
+		break;
+	case 'e':
+		if (argc > 0)
+			--argc, ++argv;
+		goto run;
+	case 'f':
+		opt_font = EARGF(usage());
+		break;
+	case 'o':
+		opt_io = EARGF(usage());
+		break;
+	case 'l':
+		opt_line = EARGF(usage());
+		break;
+	case 'n':
+		opt_name = EARGF(usage());
+		break;
+	case 'p':
+		opt_realtime = 1;
+		/* FALLTHROUGH */
+	case 'P':
+		opt_play = EARGF(usage());
+		break;
+	case 'r':
+		opt_rec = EARGF(usage());
+		break;
+	case 't':
+	case 'T':
+		opt_title = EARGF(usage());
+		break;
+	case 'w':
+		opt_embed = EARGF(usage());
+		break;
+	case 'v':
+		die("%s " VERSION " (c) 2010-2016 st engineers\n", argv0);
+		break;
+	default:
+		usage();
+	} ARGEND;
+
+run:
+	if (argc > 0) {
+		/* eat all remaining arguments */
+		opt_cmd = argv;
+		if (!opt_title && !opt_line)
+			opt_title = basename(xstrdup(argv[0]));
+	}
+	setlocale(LC_CTYPE, "");
+	tnew(MAX(cols, 1), MAX(rows, 1));
+	wlinit();
+	selinit();
+	run();
+
+	return 0;
+}
+